@@ -0,0 +1,96 @@
+#include "Event.hpp"
+#include "EventHandler.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+class Receiver {
+public:
+    void on_value(const void* psender, int value) { total.fetch_add(value, std::memory_order_relaxed); }
+
+    std::atomic<std::int64_t> total = 0;
+};
+
+/**
+ * @brief Event with the given number of subscribed receivers.
+ */
+class Fixture {
+public:
+    explicit Fixture(std::size_t handler_count) : receivers(handler_count)
+    {
+        for (auto& receiver : receivers) {
+            event += core::EventHandler::bind(&receiver, &Receiver::on_value);
+        }
+    }
+
+    std::vector<Receiver> receivers;
+    core::Event<int> event;
+};
+
+/**
+ * @brief Synchronous fan-out to all handlers. Arguments: handler count.
+ */
+void BM_EventNotify(benchmark::State& state)
+{
+    Fixture fixture(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        fixture.event.notify(nullptr, 1);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * @brief Fan-out via thread pool, one task per handler, waits for all results. Arguments: handler count.
+ */
+void BM_EventNotifyAsync(benchmark::State& state)
+{
+    Fixture fixture(static_cast<std::size_t>(state.range(0)));
+    fixture.event.init_thread_pool(std::thread::hardware_concurrency(), 0);
+    for (auto _ : state) {
+        for (auto& result : fixture.event.notify_async(nullptr, 1)) {
+            benchmark::DoNotOptimize(result.get());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * @brief Fan-out via thread pool, handlers are split evenly between pool threads. Arguments: handler count.
+ */
+void BM_EventNotifyAsyncBatched(benchmark::State& state)
+{
+    Fixture fixture(static_cast<std::size_t>(state.range(0)));
+    fixture.event.init_thread_pool(std::thread::hardware_concurrency(), 0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(fixture.event.notify_async_batched(nullptr, 1).get());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * @brief Subscribe one handler and remove it by the token while the event has other subscribers.
+ * Arguments: handler count.
+ */
+void BM_EventSubscribeUnsubscribe(benchmark::State& state)
+{
+    Fixture fixture(static_cast<std::size_t>(state.range(0)));
+    Receiver receiver;
+    for (auto _ : state) {
+        auto subscription = fixture.event.subscribe(core::EventHandler::bind(&receiver, &Receiver::on_value));
+        subscription.disconnect();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(BM_EventNotify)->ArgName("handlers")->RangeMultiplier(10)->Range(1, 1000);
+BENCHMARK(BM_EventNotifyAsync)->ArgName("handlers")->RangeMultiplier(10)->Range(1, 1000)->UseRealTime();
+BENCHMARK(BM_EventNotifyAsyncBatched)->ArgName("handlers")->RangeMultiplier(10)->Range(1, 1000)->UseRealTime();
+BENCHMARK(BM_EventSubscribeUnsubscribe)->ArgName("handlers")->RangeMultiplier(10)->Range(1, 1000);
@@ -0,0 +1,75 @@
+#include "TaskQueue.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+
+namespace {
+
+constexpr std::uint32_t max_queue_size = 1024;
+
+core::TaskQueue& queue_of_type(core::TaskQueueType type)
+{
+    static std::array<core::TaskQueue, 3> queues{core::TaskQueue(max_queue_size, core::TaskQueueType::Locked),
+                                                  core::TaskQueue(max_queue_size, core::TaskQueueType::LockFree),
+                                                  core::TaskQueue(max_queue_size, core::TaskQueueType::Deadline)};
+    return queues[static_cast<std::size_t>(type)];
+}
+
+/**
+ * @brief Push and pop one task per iteration. With several benchmark threads all of them share the queue.
+ * Arguments: queue type.
+ */
+void BM_TaskQueuePushPop(benchmark::State& state)
+{
+    auto& queue = queue_of_type(static_cast<core::TaskQueueType>(state.range(0)));
+    core::Task task;
+    for (auto _ : state) {
+        core::Task pushed(static_cast<core::TaskPriority>(state.iterations() % core::task_priority_count));
+        pushed.assign_detached([] {});
+        queue.push(std::move(pushed));
+        benchmark::DoNotOptimize(queue.try_pop(task));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief Push a batch of tasks with mixed priorities, then drain the queue.
+ * Arguments: queue type, batch size.
+ */
+void BM_TaskQueueBatch(benchmark::State& state)
+{
+    const auto type = static_cast<core::TaskQueueType>(state.range(0));
+    const auto batch = static_cast<std::size_t>(state.range(1));
+    core::TaskQueue queue(max_queue_size, type);
+    core::Task task;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < batch; ++i) {
+            core::Task pushed(static_cast<core::TaskPriority>(i % core::task_priority_count));
+            pushed.assign_detached([] {});
+            queue.push(std::move(pushed));
+        }
+        while (queue.try_pop(task)) {
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+void queue_type_arguments(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({"type"});
+    for (const auto type : {core::TaskQueueType::Locked, core::TaskQueueType::LockFree, core::TaskQueueType::Deadline}) {
+        benchmark->Arg(static_cast<std::int64_t>(type));
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BM_TaskQueuePushPop)->Apply(queue_type_arguments)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_TaskQueueBatch)
+  ->ArgNames({"type", "batch"})
+  ->ArgsProduct({{static_cast<std::int64_t>(core::TaskQueueType::Locked),
+                  static_cast<std::int64_t>(core::TaskQueueType::LockFree),
+                  static_cast<std::int64_t>(core::TaskQueueType::Deadline)},
+                 {16, 256, 1024}});
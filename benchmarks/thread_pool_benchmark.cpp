@@ -0,0 +1,89 @@
+#include "ThreadPool.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::int64_t tasks_per_iteration = 10000;
+
+/**
+ * @brief Push tasks_per_iteration empty tasks from outside the pool and wait until they are executed.
+ * Arguments: thread count, scheduling policy.
+ */
+void BM_ThreadPoolThroughput(benchmark::State& state)
+{
+    core::ThreadPool pool(static_cast<std::uint32_t>(state.range(0)), 0,
+                          static_cast<core::SchedulingPolicy>(state.range(1)));
+    std::atomic<std::int64_t> executed = 0;
+    for (auto _ : state) {
+        executed.store(0, std::memory_order_relaxed);
+        for (std::int64_t i = 0; i < tasks_per_iteration; ++i) {
+            pool.post([&executed] { executed.fetch_add(1, std::memory_order_relaxed); });
+        }
+        while (executed.load(std::memory_order_acquire) != tasks_per_iteration) {
+            std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * tasks_per_iteration);
+}
+
+/**
+ * @brief Push the same tasks as BM_ThreadPoolThroughput under one critical section.
+ * Arguments: thread count, scheduling policy.
+ */
+void BM_ThreadPoolBulkThroughput(benchmark::State& state)
+{
+    core::ThreadPool pool(static_cast<std::uint32_t>(state.range(0)), 0,
+                          static_cast<core::SchedulingPolicy>(state.range(1)));
+    std::atomic<std::int64_t> executed = 0;
+    std::vector<core::Task> tasks(tasks_per_iteration);
+    for (auto _ : state) {
+        executed.store(0, std::memory_order_relaxed);
+        for (auto& task : tasks) {
+            task.assign_detached([&executed] { executed.fetch_add(1, std::memory_order_relaxed); });
+        }
+        pool.push_tasks(tasks);
+        while (executed.load(std::memory_order_acquire) != tasks_per_iteration) {
+            std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * tasks_per_iteration);
+}
+
+/**
+ * @brief Round trip of one empty task: push, execution and completion of its future.
+ * Arguments: thread count, scheduling policy.
+ */
+void BM_ThreadPoolEmptyTaskLatency(benchmark::State& state)
+{
+    core::ThreadPool pool(static_cast<std::uint32_t>(state.range(0)), 0,
+                          static_cast<core::SchedulingPolicy>(state.range(1)));
+    for (auto _ : state) {
+        core::Task task;
+        auto result = task.assign([] {});
+        pool.push_task(std::move(task));
+        benchmark::DoNotOptimize(result.get());
+    }
+}
+
+void thread_pool_arguments(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({"threads", "policy"});
+    for (const auto policy : {core::SchedulingPolicy::SharedQueue, core::SchedulingPolicy::WorkStealing,
+                              core::SchedulingPolicy::NumaWorkStealing}) {
+        for (const std::int64_t threads : {1, 2, 4, 8}) {
+            benchmark->Args({threads, static_cast<std::int64_t>(policy)});
+        }
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BM_ThreadPoolThroughput)->Apply(thread_pool_arguments)->UseRealTime();
+BENCHMARK(BM_ThreadPoolBulkThroughput)->Apply(thread_pool_arguments)->UseRealTime();
+BENCHMARK(BM_ThreadPoolEmptyTaskLatency)->Apply(thread_pool_arguments)->UseRealTime();
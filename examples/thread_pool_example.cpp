@@ -28,7 +28,7 @@ int main(int argc, char** argv)
     for (int j = 0; j < 100; ++j) {
       core::Task task(core::TaskPriority::Medium);
       results.emplace_back(task.assign(worker, "From thread pool " + std::to_string(j)));
-      pool.push_task(task);
+      pool.push_task(std::move(task));
     }
     for (auto& result : results) {
       std::cout << result.get() << std::endl;
@@ -44,7 +44,7 @@ int main(int argc, char** argv)
     for (int j = 0; j < 100; ++j) {
       core::Task task(core::TaskPriority::Medium);
       results.emplace_back(task.assign(&test, &Test::Sum, j, j + 1));
-      pool.push_task(task);
+      pool.push_task(std::move(task));
     }
     for (auto& result : results) {
       std::cout << result.get() << std::endl;
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "EventHandlerImpl.hpp"
+#include "ThreadPool.hpp"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace core {
+
+/**
+ * @brief Event handler of the conflating subscription. Notification replaces the pending value of
+ * the subscriber and schedules a thread pool task only if there is no scheduled one, so the subscriber
+ * has at most one task in the pool and receives the latest value. The wrapped handler is not called
+ * concurrently with itself. Tasks executed after the subscription is removed do nothing.
+ * Delivery tasks are pushed according to the overflow policy of the pool. If the pool rejects a delivery task
+ * or drops an expired one, the pending value is dropped and the next notification schedules delivery again.
+ * The thread pool must outlive the subscription.
+ * @tparam T Argument type.
+ */
+template <typename T>
+class ConflatingEventHandler : public EventHandlerImpl<T> {
+public:
+  /**
+   * @brief Construct a new ConflatingEventHandler object.
+   * @param pHandler[in] Wrapped handler.
+   * @param pool[in] Thread pool executing the wrapped handler.
+   * @param priority[in] Priority of the delivery tasks.
+   * @param deadline[in] Deadline of the delivery tasks relative to their scheduling, 0 disables it.
+   */
+  ConflatingEventHandler(EventHandlerImplPtr<T> pHandler, ThreadPool& pool,
+                         TaskPriority priority = TaskPriority::Medium,
+                         std::chrono::nanoseconds deadline = std::chrono::nanoseconds(0))
+    : EventHandlerImpl<T>(MakeWrappedEventHandlerKey<ConflatingEventHandler<T>>(*pHandler)),
+      pState_(std::make_shared<State>(std::move(pHandler), pool, priority, deadline))
+  {
+  }
+
+  /**
+   * @brief Stop delivery when the subscription is removed. Pending value is dropped.
+   */
+  virtual void OnUnsubscribed() override final
+  {
+    std::lock_guard lock(pState_->mutex);
+    pState_->active = false;
+    pState_->pending.reset();
+  }
+
+  /**
+   * @brief Replace the pending value and schedule delivery if it is not scheduled yet.
+   * @param[in] psender Pointer to the sender.
+   * @param[in] arg Passed argument.
+   */
+  virtual void OnEvent(const void* psender, const T& arg) override final
+  {
+    {
+      std::lock_guard lock(pState_->mutex);
+      if (!pState_->active) {
+        return;
+      }
+      pState_->psender = psender;
+      pState_->pending = arg;
+      if (pState_->scheduled) {
+        pState_->conflated++;
+        return;
+      }
+      pState_->scheduled = true;
+    }
+    Schedule(pState_);
+  }
+
+  /**
+   * @brief Сhecks the current and passed event handler.
+   * Compares keys of the handlers computed at construction.
+   * @param[in] pHandler Pointer to the event handler.
+   * @return true If both handlers are conflating and wrap handlers bound to the same function.
+   * @return false Otherwise.
+   */
+  virtual bool IsBindedToSameFunctionAs(const EventHandlerImplBase<T>* pHandler) const override final
+  {
+    return pHandler && this->Key() == pHandler->Key();
+  }
+
+  /**
+   * @brief Return number of values replaced by newer ones before delivery.
+   * @return std::uint64_t Number of conflated values.
+   */
+  std::uint64_t GetConflatedCount() const
+  {
+    std::lock_guard lock(pState_->mutex);
+    return pState_->conflated;
+  }
+
+private:
+  /**
+   * @brief Pending value and scheduling state shared with the scheduled task.
+   */
+  struct State {
+    State(EventHandlerImplPtr<T> pHandler, ThreadPool& pool, TaskPriority priority, std::chrono::nanoseconds deadline)
+      : pHandler(std::move(pHandler)), delegate(this->pHandler->ToDelegate()), pool(pool), priority(priority),
+        deadline(deadline)
+    {
+    }
+
+    EventHandlerImplPtr<T> pHandler;
+    EventDelegate<T> delegate;
+    ThreadPool& pool;
+    const TaskPriority priority;
+    const std::chrono::nanoseconds deadline;
+    std::mutex mutex;
+    const void* psender = nullptr;
+    std::optional<T> pending;
+    bool scheduled = false;
+    bool active = true;
+    std::uint64_t conflated = 0;
+  };
+
+  /**
+   * @brief Function of the delivery task. If the task is destroyed without execution,
+   * the pending value is dropped and the subscriber is not scheduled anymore.
+   */
+  struct Delivery {
+    explicit Delivery(std::shared_ptr<State> pState) : pState(std::move(pState)) {}
+    Delivery(Delivery&&) noexcept = default;
+    Delivery& operator=(Delivery&&) noexcept = default;
+
+    ~Delivery()
+    {
+      if (pState) {
+        std::lock_guard lock(pState->mutex);
+        pState->pending.reset();
+        pState->scheduled = false;
+      }
+    }
+
+    void operator()() { Deliver(std::exchange(pState, nullptr)); }
+
+    std::shared_ptr<State> pState;
+  };
+
+  /**
+   * @brief Push delivery task to the pool according to its overflow policy. A rejected task is destroyed,
+   * see Delivery.
+   * @param pState[in] Subscriber state.
+   */
+  static void Schedule(const std::shared_ptr<State>& pState)
+  {
+    Task task(pState->priority);
+    if (pState->deadline.count() != 0) {
+      task.set_deadline(Task::Clock::now() + std::chrono::duration_cast<Task::Clock::duration>(pState->deadline));
+    }
+    task.assign_detached(Delivery(pState));
+    pState->pool.push_tasks_nothrow({&task, 1});
+  }
+
+  /**
+   * @brief Call the wrapped handler with the pending value. If a newer value arrived during the call,
+   * delivery is scheduled again instead of looping, so other tasks are not starved.
+   * @param pState[in] Subscriber state.
+   */
+  static void Deliver(const std::shared_ptr<State>& pState)
+  {
+    std::optional<T> value;
+    const void* psender;
+    {
+      std::lock_guard lock(pState->mutex);
+      value.swap(pState->pending);
+      psender = pState->psender;
+    }
+    const auto reschedule = [&pState] {
+      std::lock_guard lock(pState->mutex);
+      pState->scheduled = pState->active && pState->pending.has_value();
+      return pState->scheduled;
+    };
+    if (value) {
+      try {
+        pState->delegate(psender, *value);
+      } catch (...) {
+        if (reschedule()) {
+          Schedule(pState);
+        }
+        throw;
+      }
+    }
+    if (reschedule()) {
+      Schedule(pState);
+    }
+  }
+
+  /**
+   * @brief Subscriber state.
+   */
+  std::shared_ptr<State> pState_;
+};
+}  // namespace core
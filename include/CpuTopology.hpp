@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace core {
+
+/**
+ * @brief NUMA node and its CPUs.
+ */
+struct NumaNode {
+  /**
+   * @brief Node id assigned by the system.
+   */
+  std::uint32_t id = 0;
+  /**
+   * @brief CPUs of the node.
+   */
+  std::vector<std::uint32_t> cpus;
+};
+
+/**
+ * @brief This class provides CPU topology of the machine and thread placement.
+ * Topology is read from sysfs and thread affinity is set via pthread_setaffinity_np(), so placement works on Linux only.
+ * On other systems all CPUs belong to one node and affinity is not set.
+ */
+class CpuTopology {
+public:
+  /**
+   * @brief Return CPUs the process may run on.
+   * @return std::vector<std::uint32_t> Sorted CPU numbers.
+   */
+  static std::vector<std::uint32_t> allowed_cpus();
+
+  /**
+   * @brief Return NUMA nodes with CPUs the process may run on. Nodes without such CPUs are skipped.
+   * @return std::vector<NumaNode> Nodes ordered by id, a single node with all allowed CPUs if topology is unknown.
+   */
+  static std::vector<NumaNode> numa_nodes();
+
+  /**
+   * @brief Parse CPU list in sysfs format, e.g. "0-3,8,10-11".
+   * @param list CPU list.
+   * @return std::vector<std::uint32_t> CPU numbers, malformed items are skipped.
+   */
+  static std::vector<std::uint32_t> parse_cpu_list(const std::string& list);
+
+  /**
+   * @brief Restrict the thread to the CPUs.
+   * @param thread Running thread.
+   * @param cpus CPU numbers, must not be empty.
+   * @return true If the affinity was set.
+   * @return false Otherwise.
+   */
+  static bool set_affinity(std::thread& thread, std::span<const std::uint32_t> cpus);
+
+  /**
+   * @brief Return CPU the calling thread is running on.
+   * @return std::optional<std::uint32_t> CPU number, empty if it is unknown.
+   */
+  static std::optional<std::uint32_t> current_cpu();
+};
+}  // namespace core
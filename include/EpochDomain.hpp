@@ -0,0 +1,179 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace core {
+
+/**
+ * @brief This class implement epoch based memory reclamation for read-mostly shared data (RCU).
+ * Readers enter a read section by creating Guard object: the thread publishes the current global epoch
+ * in its own record, which is not shared with other threads, so entering does not write shared memory.
+ * Writers replace shared data atomically and retire the old object, which is deleted when all read sections
+ * started before the replacement are finished.
+ * Read sections may be bound to a scope, e.g. the address of the replaced pointer, so writers waiting
+ * for readers of one object are not stalled by readers of other objects.
+ */
+class EpochDomain {
+public:
+  /**
+   * @brief RAII read section. Read sections may be nested.
+   */
+  class Guard {
+  public:
+    /**
+     * @brief Enter read section.
+     * @param scope[in] Address identifying the data read by the section, nullptr if the section may read any data.
+     */
+    explicit Guard(const void* scope = nullptr);
+    ~Guard();
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+  };
+
+  /**
+   * @brief Return the global domain. The domain is never destroyed, so it may be used by any thread at exit.
+   * @return EpochDomain& Global domain.
+   */
+  static EpochDomain& instance();
+
+  /**
+   * @brief Copy ctor.
+   * This constructor was deleted.
+   */
+  EpochDomain(const EpochDomain&) = delete;
+
+  /**
+   * @brief Copy assignment operator.
+   * This opetator was deleted.
+   * @return EpochDomain&
+   */
+  EpochDomain& operator=(const EpochDomain&) = delete;
+
+  /**
+   * @brief Retire the object which is not reachable by new readers anymore.
+   * The object is deleted as soon as no read section can access it.
+   * @param ptr Retired object.
+   * @param deleter Function deleting the object.
+   */
+  void retire(void* ptr, void (*deleter)(void*));
+
+  /**
+   * @brief Retire the object allocated via new.
+   * @tparam T Object type.
+   * @param ptr Retired object.
+   */
+  template <typename T>
+  void retire(const T* ptr)
+  {
+    if (ptr) {
+      retire(const_cast<T*>(ptr), [](void* p) { delete static_cast<T*>(p); });
+    }
+  }
+
+  /**
+   * @brief Wait until read sections started before the call are finished.
+   * Returns immediately if the calling thread is in a read section: the thread may be waited
+   * by another one, so waiting there could deadlock.
+   * @param scope[in] Wait only for read sections of the scope and sections without scope, nullptr waits for all.
+   */
+  void synchronize(const void* scope = nullptr);
+
+  /**
+   * @brief Delete retired objects which are not accessible by read sections.
+   */
+  void reclaim();
+
+private:
+  /**
+   * @brief Per-thread record. Aligned to the cache line, so publishing epoch does not touch other records.
+   */
+  struct alignas(64) Record {
+    /**
+     * @brief Max number of nested scopes kept per thread, deeper read sections are treated as sections without scope.
+     */
+    static constexpr std::uint32_t max_scopes = 8;
+
+    /**
+     * @brief Check the thread is in a read section of the scope or in a section without scope.
+     * @param scope[in] Scope, nullptr matches any section.
+     * @return true If the section may read data of the scope.
+     * @return false Otherwise.
+     */
+    bool holds(const void* scope) const;
+
+    /**
+     * @brief Epoch of the current read section, 0 if the thread is not in a read section.
+     */
+    std::atomic<std::uint64_t> epoch{0};
+    /**
+     * @brief Scopes of the nested read sections, nullptr if the nesting level is not used.
+     */
+    std::atomic<const void*> scopes[max_scopes] = {};
+    /**
+     * @brief True while the record is owned by a thread.
+     */
+    std::atomic_bool in_use{true};
+    /**
+     * @brief Next record in the domain list.
+     */
+    Record* next = nullptr;
+  };
+
+  /**
+   * @brief Retired object.
+   */
+  struct Retired {
+    void* ptr;
+    void (*deleter)(void*);
+    std::uint64_t epoch;
+  };
+
+  friend class Guard;
+  friend struct ThreadRecord;
+
+  EpochDomain();
+
+  /**
+   * @brief Enter read section in the current thread.
+   * @param scope[in] Scope of the section, nullptr if the section may read any data.
+   */
+  void enter(const void* scope);
+
+  /**
+   * @brief Leave read section in the current thread.
+   */
+  void leave();
+
+  /**
+   * @brief Take a free record or create a new one. Records are never deleted, they are reused by new threads.
+   * @return Record* Record owned by the calling thread.
+   */
+  Record* acquire_record();
+
+  /**
+   * @brief Return min epoch of the active read sections.
+   * @return std::uint64_t Min epoch or UINT64_MAX if there are no active read sections.
+   */
+  std::uint64_t min_active_epoch() const;
+
+  /**
+   * @brief Global epoch, incremented on every retire() and synchronize().
+   */
+  std::atomic<std::uint64_t> _epoch;
+  /**
+   * @brief List of per-thread records.
+   */
+  std::atomic<Record*> _records;
+  /**
+   * @brief Mutex for retired objects.
+   */
+  std::mutex _retired_mutex;
+  /**
+   * @brief Retired objects waiting for deletion.
+   */
+  std::vector<Retired> _retired;
+};
+}  // namespace core
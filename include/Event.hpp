@@ -1,7 +1,10 @@
 #pragma once
 
+#include "ConflatingEventHandler.hpp"
 #include "EventBase.hpp"
 
+#include <stdexcept>
+
 namespace core {
 
 using EventHandlerAsyncResult = std::future<bool>;
@@ -21,25 +24,37 @@ class Event : public EventBase<T> {
 public:
   /**
    * @brief This function provides sync notification. Notification
-   * are thread safe process.
+   * are thread safe process and does not take locks. Coroutines waiting for next() are resumed in the calling thread.
    * @param psender[in] Event sender.
    * @param arg[in] Argument sender for observers/subscribers.
    */
   void notify(const void* psender, const T& arg)
   {
-    std::shared_lock lock(mutex_);
-    for (const auto& pHandler : handlers_) {
-      if (pHandler)
-        pHandler->OnEvent(psender, arg);
+    {
+      const EpochDomain::Guard guard(&handlers_);
+      if (const auto* pHandlers = handlers_.load(std::memory_order_acquire)) {
+        if (pHandlers->instrumentation) {
+          this->notify_instrumented(*pHandlers, psender, arg);
+        } else {
+          for (std::size_t i = 0, count = pHandlers->size(); i < count; ++i) {
+            if (!pHandlers->is_removed(i)) {
+              pHandlers->delegates[i](psender, arg);
+            }
+          }
+        }
+      }
     }
+    this->resume_waiters(arg);
   }
   /**
    * @brief This function provides async notification. Notification are provided
-   * via thread pool. This process are thread safe.
+   * via thread pool. Tasks for all handlers are pushed to the thread pool at once. This process are thread safe.
+   * Tasks which do not fit the queue are handled according to the overflow policy of the pool, Throw policy
+   * rejects them without throwing. Coroutines waiting for next() are resumed in the pool threads.
    * @param psender[in] Event sender.
    * @param arg[in] Argument sender for observers/subscribers.
    * @return std::vector<EventHandlerAsyncResult> Return execution result for every handler for the event.
-   * operation status.
+   * operation status. Results of rejected handler tasks report broken promise.
    */
   std::vector<EventHandlerAsyncResult> notify_async(const void* psender, const T& arg)
   {
@@ -47,19 +62,171 @@ public:
       throw std::domain_error("Thread pool was not setted for async notification!");
     }
 
+    const TraceRecorder::Scope trace("notify_async", "event");
+    std::vector<EventHandlerAsyncResult> results;
+    std::vector<Task> tasks;
+    {
+      const EpochDomain::Guard guard(&handlers_);
+      if (const auto* pHandlers = handlers_.load(std::memory_order_acquire)) {
+        const auto count = pHandlers->size();
+        results.reserve(count);
+        tasks.reserve(count);
+        const auto deadline = this->task_deadline();
+        for (std::size_t i = 0; i < count; ++i) {
+          if (pHandlers->is_removed(i)) {
+            continue;
+          }
+          auto task = this->make_task(deadline);
+          if (const auto& pOwner = pHandlers->owners[i]) {
+            // The task shares the custom handler, so it stays alive if it is removed before the task is executed.
+            results.push_back(task.assign(pOwner, &EventHandlerImpl<T>::OnEvent, psender, arg));
+          } else {
+            results.push_back(task.assign(
+              [delegate = pHandlers->delegates[i]](const void* psender, const T& arg) { delegate(psender, arg); }, psender, arg));
+          }
+          tasks.push_back(std::move(task));
+        }
+        payload_copies_.fetch_add(tasks.size(), std::memory_order_relaxed);
+      }
+    }
+    // Tasks rejected by the overflow policy are destroyed, their futures report broken promise.
+    thread_pool_->push_tasks_nothrow(tasks);
+    this->resume_waiters_async(arg);
+    return results;
+  }
+
+  /**
+   * @brief This function provides async notification with the argument moved into a single
+   * reference-counted payload shared by all handler tasks.
+   * @param psender[in] Event sender.
+   * @param arg[in] Argument sender for observers/subscribers.
+   * @return std::vector<EventHandlerAsyncResult> Return execution result for every handler for the event.
+   */
+  std::vector<EventHandlerAsyncResult> notify_async(const void* psender, T&& arg)
+  {
+    if(!thread_pool_) {
+      throw std::domain_error("Thread pool was not setted for async notification!");
+    }
+    payload_allocations_.fetch_add(1, std::memory_order_relaxed);
+    return notify_async(psender, std::make_shared<const T>(std::move(arg)));
+  }
+
+  /**
+   * @brief This function provides async notification with immutable payload shared by all handler tasks.
+   * The argument is not copied, the tasks keep a reference to the payload until they are executed.
+   * @param psender[in] Event sender.
+   * @param pArg[in] Argument sender for observers/subscribers.
+   * @return std::vector<EventHandlerAsyncResult> Return execution result for every handler for the event.
+   */
+  std::vector<EventHandlerAsyncResult> notify_async(const void* psender, std::shared_ptr<const T> pArg)
+  {
+    if(!thread_pool_) {
+      throw std::domain_error("Thread pool was not setted for async notification!");
+    }
+    if (!pArg) {
+      throw std::invalid_argument("Event payload is empty!");
+    }
+
+    const TraceRecorder::Scope trace("notify_async", "event");
     std::vector<EventHandlerAsyncResult> results;
-    results.reserve(handlers_.size());
-    std::shared_lock lock(mutex_);
-    for (const auto& pHandler : handlers_) {
-      if (pHandler) {
-            Task task;
-            auto result = task.assign(pHandler.get(), &EventHandlerImpl<T>::OnEvent, psender, arg);
-            thread_pool_->push_task(task);
-            results.push_back(std::move(result));
+    std::vector<Task> tasks;
+    {
+      const EpochDomain::Guard guard(&handlers_);
+      if (const auto* pHandlers = handlers_.load(std::memory_order_acquire)) {
+        const auto count = pHandlers->size();
+        results.reserve(count);
+        tasks.reserve(count);
+        const auto deadline = this->task_deadline();
+        for (std::size_t i = 0; i < count; ++i) {
+          if (pHandlers->is_removed(i)) {
+            continue;
+          }
+          auto task = this->make_task(deadline);
+          if (const auto& pOwner = pHandlers->owners[i]) {
+            results.push_back(task.assign(
+              [pOwner, pArg](const void* psender) { pOwner->OnEvent(psender, *pArg); }, psender));
+          } else {
+            results.push_back(task.assign(
+              [delegate = pHandlers->delegates[i], pArg](const void* psender) { delegate(psender, *pArg); }, psender));
+          }
+          tasks.push_back(std::move(task));
+        }
       }
     }
+    // Tasks rejected by the overflow policy are destroyed, their futures report broken promise.
+    thread_pool_->push_tasks_nothrow(tasks);
+    this->resume_waiters_async(*pArg);
     return results;
   }
+
+  /**
+   * @brief This function provides batched async notification. Handlers are split into chunks,
+   * one thread pool task is created per chunk and all chunks share a single copy of the argument.
+   * Chunks are pushed according to the overflow policy of the pool like notify_async().
+   * Coroutines waiting for next() are resumed in the pool threads.
+   * @param psender[in] Event sender.
+   * @param arg[in] Argument sender for observers/subscribers.
+   * @param chunk_size[in] Number of handlers per task, 0 splits handlers evenly between pool threads.
+   * @return EventHandlerAsyncResult Completion of all handlers. It rethrows the first exception thrown by a handler,
+   * or reports broken promise if a chunk was rejected or dropped by the pool.
+   */
+  EventHandlerAsyncResult notify_async_batched(const void* psender, const T& arg, std::size_t chunk_size = 0)
+  {
+    if(!thread_pool_) {
+      throw std::domain_error("Thread pool was not setted for async notification!");
+    }
+    auto result = this->notify_batched(chunk_size, psender, arg);
+    payload_copies_.fetch_add(1, std::memory_order_relaxed);
+    this->resume_waiters_async(arg);
+    return result;
+  }
+
+  /**
+   * @brief Subscribe the handler in conflating mode. Notifications replace the pending value of the subscriber
+   * and the subscriber is scheduled to the thread pool at most once until it runs, so it receives the latest value
+   * and the pool queue does not grow with the notification rate. The subscription must be removed before
+   * the thread pool is replaced by init_thread_pool().
+   * Priority and deadline of the delivery tasks are set per subscription, the settings of the event are not used.
+   * @param[in] pHandler Event handler for current event.
+   * @param[in] priority Priority of the delivery tasks.
+   * @param[in] deadline Deadline of the delivery tasks relative to their scheduling, 0 disables it.
+   * @return Subscription Token removing the subscription on destruction. Empty token is returned
+   * if the handler is empty or already has a conflating subscription.
+   */
+  [[nodiscard]] Subscription subscribe_conflated(EventHandlerImplPtr<T> pHandler,
+                                                 TaskPriority priority = TaskPriority::Medium,
+                                                 std::chrono::nanoseconds deadline = std::chrono::nanoseconds(0))
+  {
+    if(!thread_pool_) {
+      throw std::domain_error("Thread pool was not setted for async notification!");
+    }
+    if (!pHandler) {
+      return {};
+    }
+    return this->subscribe(std::make_unique<ConflatingEventHandler<T>>(std::move(pHandler), *thread_pool_, priority, deadline));
+  }
+
+  /**
+   * @brief Return number of argument copies made by async notifications.
+   * @return std::uint64_t Copy count.
+   */
+  std::uint64_t get_payload_copy_count() const { return payload_copies_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Return number of shared payloads allocated by async notifications.
+   * @return std::uint64_t Allocation count.
+   */
+  std::uint64_t get_payload_alloc_count() const { return payload_allocations_.load(std::memory_order_relaxed); }
+
+private:
+  /**
+   * @brief Number of argument copies made by async notifications.
+   */
+  std::atomic<std::uint64_t> payload_copies_ = 0;
+  /**
+   * @brief Number of shared payloads allocated by async notifications.
+   */
+  std::atomic<std::uint64_t> payload_allocations_ = 0;
 };
 
 /**
@@ -72,16 +239,26 @@ class Event<void> : public EventBase<void> {
 public:
   /**
    * @brief This function provides sync notification. Notification
-   * are thread safe process.
+   * are thread safe process and does not take locks. Coroutines waiting for next() are resumed in the calling thread.
    * @param psender[in] Event sender.
    */
   void notify(const void* psender)
   {
-    std::shared_lock lock(mutex_);
-    for (const auto& pHandler : handlers_) {
-      if (pHandler)
-        pHandler->OnEvent(psender);
+    {
+      const EpochDomain::Guard guard(&handlers_);
+      if (const auto* pHandlers = handlers_.load(std::memory_order_acquire)) {
+        if (pHandlers->instrumentation) {
+          notify_instrumented(*pHandlers, psender);
+        } else {
+          for (std::size_t i = 0, count = pHandlers->size(); i < count; ++i) {
+            if (!pHandlers->is_removed(i)) {
+              pHandlers->delegates[i](psender);
+            }
+          }
+        }
+      }
     }
+    resume_waiters();
   }
 
   /**
@@ -96,18 +273,54 @@ public:
       throw std::domain_error("Thread pool was not setted for async notification!");
     }
 
+    const TraceRecorder::Scope trace("notify_async", "event");
     std::vector<EventHandlerAsyncResult> results;
-    results.reserve(handlers_.size());
-    std::shared_lock lock(mutex_);
-    for (const auto& pHandler : handlers_) {
-      if (pHandler) {
-        Task task;
-        auto result = task.assign(pHandler.get(), &EventHandlerImpl<void>::OnEvent, psender);
-        thread_pool_->push_task(task);
-        results.emplace_back(std::move(result));
+    std::vector<Task> tasks;
+    {
+      const EpochDomain::Guard guard(&handlers_);
+      if (const auto* pHandlers = handlers_.load(std::memory_order_acquire)) {
+        const auto count = pHandlers->size();
+        results.reserve(count);
+        tasks.reserve(count);
+        const auto deadline = task_deadline();
+        for (std::size_t i = 0; i < count; ++i) {
+          if (pHandlers->is_removed(i)) {
+            continue;
+          }
+          auto task = make_task(deadline);
+          if (const auto& pOwner = pHandlers->owners[i]) {
+            // The task shares the custom handler, so it stays alive if it is removed before the task is executed.
+            results.push_back(task.assign(pOwner, &EventHandlerImpl<void>::OnEvent, psender));
+          } else {
+            results.push_back(task.assign(
+              [delegate = pHandlers->delegates[i]](const void* psender) { delegate(psender); }, psender));
+          }
+          tasks.push_back(std::move(task));
+        }
       }
     }
+    // Tasks rejected by the overflow policy are destroyed, their futures report broken promise.
+    thread_pool_->push_tasks_nothrow(tasks);
+    resume_waiters_async();
     return results;
   }
+
+  /**
+   * @brief This function provides batched async notification. Handlers are split into chunks,
+   * one thread pool task is created per chunk.
+   * @param psender[in] Event sender.
+   * @param chunk_size[in] Number of handlers per task, 0 splits handlers evenly between pool threads.
+   * @return EventHandlerAsyncResult Completion of all handlers. It rethrows the first exception thrown by a handler,
+   * or reports broken promise if a chunk was rejected or dropped by the pool.
+   */
+  EventHandlerAsyncResult notify_async_batched(const void* psender, std::size_t chunk_size = 0)
+  {
+    if(!thread_pool_) {
+      throw std::domain_error("Thread pool was not setted for async notification!");
+    }
+    auto result = notify_batched(chunk_size, psender);
+    resume_waiters_async();
+    return result;
+  }
 };
 }  // namespace core
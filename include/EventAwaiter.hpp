@@ -0,0 +1,67 @@
+#pragma once
+
+#include <coroutine>
+#include <optional>
+#include <type_traits>
+
+namespace core {
+
+template <typename T>
+class EventBase;
+
+/**
+ * @brief This class implement awaitable object returned by Event<T>::next().
+ * The awaiting coroutine is suspended until the next notification of the event and gets
+ * the notification argument as co_await result. Waiting coroutines are kept in an intrusive list,
+ * so waiting does not allocate memory and does not hold a thread.
+ * @tparam T Argument type of the event.
+ */
+template <typename T>
+class EventAwaiter {
+  friend class EventBase<T>;
+  using ArgT = std::conditional_t<std::is_void_v<T>, bool, T>;
+
+public:
+  /**
+   * @brief Construct a new EventAwaiter object.
+   * @param event[in] Awaited event.
+   */
+  explicit EventAwaiter(EventBase<T>& event) : event_(event), next_(nullptr) {}
+
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(std::coroutine_handle<> handle)
+  {
+    handle_ = handle;
+    event_.add_waiter(this);
+  }
+
+  /**
+   * @brief Return notification argument.
+   */
+  T await_resume()
+  {
+    if constexpr (!std::is_void_v<T>) {
+      return std::move(*arg_);
+    }
+  }
+
+private:
+  /**
+   * @brief Awaited event.
+   */
+  EventBase<T>& event_;
+  /**
+   * @brief Next waiter in the event list.
+   */
+  EventAwaiter* next_;
+  /**
+   * @brief Suspended coroutine.
+   */
+  std::coroutine_handle<> handle_;
+  /**
+   * @brief Notification argument.
+   */
+  std::optional<ArgT> arg_;
+};
+}  // namespace core
@@ -1,11 +1,28 @@
 #pragma once
 
+#include "EpochDomain.hpp"
+#include "EventAwaiter.hpp"
+#include "EventDispatchStats.hpp"
 #include "EventHandlerImpl.hpp"
+#include "QueuedEventHandler.hpp"
+#include "Subscription.hpp"
 #include "ThreadPoolExecutable.hpp"
+#include "TraceRecorder.hpp"
 
-#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
 #include <shared_mutex>
+#include <tuple>
+#include <vector>
 #include <type_traits>
+#include <unordered_map>
+#include <utility>
 
 namespace core {
 /**
@@ -13,10 +30,16 @@ namespace core {
  * object communication between your components in the program.
  * Add/remove forwarded event handler from observer array.
  * Adding/removing operations are thread safe.
+ * Observer array is a snapshot read by notification without locking. Adding appends the entry in place
+ * and publishes the new size, removing marks the entry, so neither copies the snapshot. The snapshot is
+ * replaced atomically when it is full or when half of its entries are removed, replaced snapshots
+ * are reclaimed via EpochDomain.
  * @tparam T
  */
 template <typename T>
 class EventBase : public ThreadPoolExecutable {
+  friend class EventAwaiter<T>;
+
 public:
   /**
    * @brief Copy ctor.
@@ -32,25 +55,100 @@ public:
   EventBase& operator=(const EventBase&) = delete;
 
   /**
-   * @brief This operator add event handler instance to observer vector.
+   * @brief Subscribe the handler to the event.
+   * The handler is converted to a delegate stored by value, custom handlers are kept alive by the event.
+   * Duplicate subscriptions are detected by hash of the bound object and function, custom handlers
+   * by hash of their Key(). Custom handlers without key match only themselves.
    * @param[in] pHandler Event handler for current event.
+   * @return Subscription Token removing the subscription on destruction. Empty token is returned
+   * if the handler is empty or already subscribed.
    */
-  EventBase<T>& operator+=(EventHandlerImplPtr<T> pHandlerToAdd)
+  [[nodiscard]] Subscription subscribe(EventHandlerImplPtr<T> pHandler)
   {
-    if (pHandlerToAdd) {
-      std::unique_lock lock(mutex_);
-      auto it = std::find_if(std::begin(handlers_), std::end(handlers_), [&pHandlerToAdd](auto& pHandler) {
-        return pHandlerToAdd->IsBindedToSameFunctionAs(pHandler.get());
-      });
-      if (it == std::end(handlers_)) {
-        handlers_.push_back(std::move(pHandlerToAdd));
+    if (!pHandler) {
+      return {};
+    }
+    const auto delegate = pHandler->ToDelegate();
+    if (!delegate) {
+      return {};
+    }
+    const auto key = pHandler->Key();
+    std::shared_ptr<EventHandlerImpl<T>> pOwner;
+    if (delegate.object() == pHandler.get()) {
+      pOwner = std::move(pHandler);
+    }
+
+    Subscription subscription;
+    const HandlerList* pOldHandlers = nullptr;
+    {
+      std::lock_guard lock(mutex_);
+      if (pOwner ? custom_index_.contains(custom_key(pOwner.get())) : index_.contains(delegate)) {
+        return {};
+      }
+      auto* pHandlers = handlers_.load(std::memory_order_relaxed);
+      if (!pHandlers || pHandlers->size() == pHandlers->capacity()) {
+        pOldHandlers = handlers_.exchange(compact(pHandlers).release(), std::memory_order_seq_cst);
+        pHandlers = handlers_.load(std::memory_order_relaxed);
+      }
+      const auto slot = acquire_slot();
+      if (pOwner) {
+        custom_index_.emplace(custom_key(pOwner.get()), slot);
+      } else {
+        index_.emplace(delegate, slot);
       }
+      // The entry after the published size is not read by notifications, it is filled before the size is published.
+      const auto position = pHandlers->size();
+      pHandlers->delegates[position] = delegate;
+      pHandlers->owners[position] = std::move(pOwner);
+      pHandlers->keys[position] = key;
+      if (pHandlers->instrumentation && pHandlers->instrumentation->stats) {
+        pHandlers->counters[position] = std::make_shared<EventDispatchCounters>();
+      }
+      slots_[slot].position = static_cast<std::uint32_t>(position);
+      positions_.push_back(slot);
+      pHandlers->count.store(position + 1, std::memory_order_release);
+
+      if (!source_) {
+        source_ = std::make_shared<Source>(this);
+      }
+      subscription = Subscription(source_, slot, slots_[slot].generation);
     }
+    EpochDomain::instance().retire(pOldHandlers);
+    return subscription;
+  }
+
+  /**
+   * @brief Subscribe the handler to the event with queued delivery. Notification only posts a message
+   * to the loop, the handler is called by the thread executing the loop.
+   * @param[in] pHandler Event handler for current event.
+   * @param[in] pLoop Event loop of the consumer thread.
+   * @return Subscription Token removing the subscription on destruction. Empty token is returned
+   * if the handler or the loop is empty, or the handler already has a queued subscription.
+   */
+  [[nodiscard]] Subscription subscribe(EventHandlerImplPtr<T> pHandler, const EventLoop::SharedPtr& pLoop)
+  {
+    if (!pHandler || !pLoop) {
+      return {};
+    }
+    return subscribe(std::make_unique<QueuedEventHandler<T>>(std::move(pHandler), pLoop));
+  }
+
+  /**
+   * @brief This operator add event handler instance to observer vector.
+   * The subscription lives until it is removed by operator-=.
+   * @param[in] pHandler Event handler for current event.
+   */
+  EventBase<T>& operator+=(EventHandlerImplPtr<T> pHandlerToAdd)
+  {
+    subscribe(std::move(pHandlerToAdd)).release();
     return *this;
   }
 
   /**
    * @brief This operator remove event handler instance from observer vector.
+   * Waits for notifications of this event running in other threads, so the removed handler is not called after return.
+   * If it is called from a handler during a notification, it does not wait to avoid deadlocks,
+   * so the removed handler may still be called by notifications running in other threads.
    * @param pHandlerToRemove[in] Removable event handler
    */
   EventBase<T>& operator-=(EventHandlerImplPtr<T> pHandlerToRemove)
@@ -58,18 +156,113 @@ public:
     if (!pHandlerToRemove) {
       return *this;
     }
+    const auto delegate = pHandlerToRemove->ToDelegate();
+    const HandlerList* pOldHandlers = nullptr;
+    std::shared_ptr<EventHandlerImpl<T>> pOwner;
     {
-      std::unique_lock lock(mutex_);
-      auto it = std::remove_if(std::begin(handlers_), std::end(handlers_), [&pHandlerToRemove](auto& pHandler) {
-        return pHandlerToRemove->IsBindedToSameFunctionAs(pHandler.get());
-      });
-      if (it != std::end(handlers_)) {
-        handlers_.erase(it);
+      std::lock_guard lock(mutex_);
+      std::uint32_t slot = npos;
+      if (delegate.object() == pHandlerToRemove.get()) {
+        if (const auto it = custom_index_.find(custom_key(pHandlerToRemove.get())); it != custom_index_.end()) {
+          slot = it->second;
+        }
+      } else if (const auto it = index_.find(delegate); it != index_.end()) {
+        slot = it->second;
+      }
+      if (slot == npos) {
+        return *this;
       }
+      pOldHandlers = erase(slot, pOwner);
+    }
+    EpochDomain::instance().synchronize(&handlers_);
+    EpochDomain::instance().retire(pOldHandlers);
+    if (pOwner) {
+      pOwner->OnUnsubscribed();
     }
     return *this;
   }
 
+  /**
+   * @brief Return awaitable object for the next notification: co_await event.next().
+   * The coroutine is resumed by notify() in the notifying thread or by notify_async() in a pool thread,
+   * co_await returns the notification argument. The event must outlive waiting coroutines.
+   * @return EventAwaiter<T> Awaitable object.
+   */
+  EventAwaiter<T> next() { return EventAwaiter<T>(*this); }
+
+  /**
+   * @brief Set priority of thread pool tasks created by async notification. Thread safe.
+   * @param[in] priority Task priority.
+   */
+  void set_priority(TaskPriority priority) { priority_.store(priority, std::memory_order_relaxed); }
+
+  /**
+   * @brief Return priority of thread pool tasks created by async notification.
+   * @return TaskPriority Task priority.
+   */
+  TaskPriority get_priority() const { return priority_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Set deadline of handler tasks created by async notification, relative to the notification time.
+   * Expired tasks are handled according to the expired task policy of the thread pool.
+   * Tasks resuming coroutines have no deadline, so coroutines are never dropped. Thread safe.
+   * @param[in] deadline Relative deadline, 0 disables it.
+   */
+  void set_deadline(std::chrono::nanoseconds deadline) { deadline_.store(deadline, std::memory_order_relaxed); }
+
+  /**
+   * @brief Return deadline of handler tasks created by async notification.
+   * @return std::chrono::nanoseconds Relative deadline, 0 if it is disabled.
+   */
+  std::chrono::nanoseconds get_deadline() const { return deadline_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Enable or disable dispatch counters of notify(). When enabled, every handler call is timed
+   * and counted per event and per handler. Counters are kept when they are disabled.
+   * @param[in] enabled True to enable counters.
+   */
+  void set_dispatch_stats_enabled(bool enabled)
+  {
+    update_instrumentation([enabled](Instrumentation& instrumentation) { instrumentation.stats = enabled; });
+  }
+
+  /**
+   * @brief Set callback reporting handler calls of notify() which took longer than the budget.
+   * @param[in] budget Max duration of a handler call.
+   * @param[in] callback Callback, empty callback disables reporting.
+   */
+  void set_slow_handler_callback(std::chrono::nanoseconds budget, SlowHandlerCallback callback)
+  {
+    update_instrumentation([budget, &callback](Instrumentation& instrumentation) {
+      instrumentation.budget = budget;
+      instrumentation.callback = std::move(callback);
+    });
+  }
+
+  /**
+   * @brief Return counters of notify() calls of the event.
+   * @return EventDispatchStats Counters.
+   */
+  EventDispatchStats get_dispatch_stats() const { return dispatch_counters_.stats(); }
+
+  /**
+   * @brief Return counters of the subscribed handler.
+   * @param[in] key Key of the handler, see EventHandlerImplBase::Key().
+   * @return EventDispatchStats Counters, zero if the handler is not subscribed or counters were never enabled.
+   */
+  EventDispatchStats get_handler_stats(const EventHandlerKey& key) const
+  {
+    const EpochDomain::Guard guard(&handlers_);
+    if (const auto* pHandlers = handlers_.load(std::memory_order_acquire)) {
+      for (std::size_t i = 0, count = pHandlers->size(); i < count; ++i) {
+        if (!pHandlers->is_removed(i) && pHandlers->keys[i] == key && pHandlers->counters[i]) {
+          return pHandlers->counters[i]->stats();
+        }
+      }
+    }
+    return {};
+  }
+
 protected:
   /**
    * @brief Default ctor EventBase class.
@@ -81,10 +274,656 @@ protected:
    * @brief Default dtor EventBase class.
    * Destroy EventBase instance.
    */
-  virtual ~EventBase() = default;
+  virtual ~EventBase()
+  {
+    std::shared_ptr<Source> source;
+    {
+      std::lock_guard lock(mutex_);
+      source = std::move(source_);
+    }
+    // Tokens which outlive the event do nothing. Disconnects running in other threads take mutex_,
+    // so they are waited without holding it.
+    if (source) {
+      source->Detach();
+    }
+    if (const auto* pHandlers = handlers_.load(std::memory_order_acquire)) {
+      // Removed handlers were already notified.
+      for (std::size_t i = 0, count = pHandlers->size(); i < count; ++i) {
+        if (pHandlers->owners[i] && !pHandlers->is_removed(i)) {
+          pHandlers->owners[i]->OnUnsubscribed();
+        }
+      }
+    }
+    delete handlers_.load(std::memory_order_acquire);
+    EpochDomain::instance().reclaim();
+  }
+
+  /**
+   * @brief Dispatch instrumentation settings of notify().
+   */
+  struct Instrumentation {
+    bool stats = false;
+    std::chrono::nanoseconds budget{0};
+    SlowHandlerCallback callback;
+  };
+
+  /**
+   * @brief Snapshot of observers. Delegates are stored contiguously, so notification
+   * scans one array. Custom handlers called via their OnEvent() are owned by the parallel array
+   * and shared between snapshots, other entries of the owners array are empty.
+   * Arrays are allocated with fixed capacity. Entries below the published size are immutable
+   * except removal marks, entries above it are written only by the subscribing thread under mutex_.
+   */
+  struct HandlerList {
+    /**
+     * @brief Construct a new Handler List object.
+     * @param capacity[in] Max number of entries.
+     */
+    explicit HandlerList(std::size_t capacity)
+      : delegates(capacity)
+      , owners(capacity)
+      , keys(capacity)
+      , counters(capacity)
+      , removed(std::make_unique<std::atomic<bool>[]>(capacity))
+    {
+    }
+
+    /**
+     * @brief Return number of published entries, including removed ones.
+     * @return std::size_t Size.
+     */
+    std::size_t size() const { return count.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Return max number of entries.
+     * @return std::size_t Capacity.
+     */
+    std::size_t capacity() const { return delegates.size(); }
+
+    /**
+     * @brief Check that the entry was removed. Marks are set before EpochDomain::synchronize(),
+     * so notifications started after it see them.
+     * @param i[in] Entry index.
+     * @return true If the entry must be skipped.
+     */
+    bool is_removed(std::size_t i) const { return removed[i].load(std::memory_order_relaxed); }
+
+    std::vector<EventDelegate<T>> delegates;
+    std::vector<std::shared_ptr<EventHandlerImpl<T>>> owners;
+    /**
+     * @brief Keys of the handlers, used to identify handlers in dispatch counters and slow handler reports.
+     */
+    std::vector<EventHandlerKey> keys;
+    /**
+     * @brief Dispatch counters of the handlers, shared between snapshots. Empty until counters are enabled.
+     */
+    std::vector<std::shared_ptr<EventDispatchCounters>> counters;
+    /**
+     * @brief Dispatch instrumentation settings, nullptr if notify() is not instrumented.
+     */
+    std::shared_ptr<const Instrumentation> instrumentation;
+    /**
+     * @brief Removal marks of the entries.
+     */
+    std::unique_ptr<std::atomic<bool>[]> removed;
+    /**
+     * @brief Number of published entries.
+     */
+    std::atomic<std::size_t> count = 0;
+  };
+
+  /**
+   * @brief Call handlers of the snapshot with timing, update dispatch counters and report slow handlers.
+   * The first exception thrown by a handler stops the notification and is rethrown.
+   * @param handlers[in] Snapshot with instrumentation.
+   * @param psender[in] Event sender.
+   * @param arg[in] Notification argument, nothing for Event<void>.
+   */
+  template <typename... A>
+  void notify_instrumented(const HandlerList& handlers, const void* psender, const A&... arg)
+  {
+    using Clock = std::chrono::steady_clock;
+    const auto& instrumentation = *handlers.instrumentation;
+    const auto notify_start = Clock::now();
+    auto end = notify_start;
+    // The clock is read again right before every call, so counter updates and the slow handler callback
+    // are not charged to the next handler.
+    const auto finish = [&](std::size_t i, Clock::time_point start, bool failed) {
+      end = Clock::now();
+      const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+      if (instrumentation.stats && handlers.counters[i]) {
+        handlers.counters[i]->record(latency, failed);
+      }
+      if (instrumentation.callback && latency > instrumentation.budget) {
+        instrumentation.callback(handlers.keys[i], latency);
+      }
+    };
+    auto first = true;
+    for (std::size_t i = 0, count = handlers.size(); i < count; ++i) {
+      if (handlers.is_removed(i)) {
+        continue;
+      }
+      const auto start = std::exchange(first, false) ? notify_start : Clock::now();
+      try {
+        handlers.delegates[i](psender, arg...);
+      } catch (...) {
+        finish(i, start, true);
+        if (instrumentation.stats) {
+          dispatch_counters_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - notify_start), true);
+        }
+        throw;
+      }
+      finish(i, start, false);
+    }
+    if (instrumentation.stats) {
+      dispatch_counters_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - notify_start), false);
+    }
+  }
+
+  /**
+   * @brief Return deadline of handler tasks created by the current notification.
+   * @return Task::Clock::time_point Deadline, Task::no_deadline if it is disabled.
+   */
+  Task::Clock::time_point task_deadline() const
+  {
+    const auto deadline = deadline_.load(std::memory_order_relaxed);
+    return deadline.count() == 0 ? Task::no_deadline
+                                 : Task::Clock::now() + std::chrono::duration_cast<Task::Clock::duration>(deadline);
+  }
+
+  /**
+   * @brief Create handler task with the event priority.
+   * @param[in] deadline Task deadline returned by task_deadline().
+   * @return Task Empty task.
+   */
+  Task make_task(Task::Clock::time_point deadline) const
+  {
+    Task task(priority_.load(std::memory_order_relaxed));
+    task.set_deadline(deadline);
+    return task;
+  }
+
+  /**
+   * @brief Resume all waiting coroutines in the current thread.
+   * @param arg[in] Notification argument, nothing for Event<void>.
+   */
+  template <typename... A>
+  void resume_waiters(const A&... arg)
+  {
+    auto* pWaiter = take_waiters();
+    while (pWaiter) {
+      // The waiter lives in the coroutine frame and may be destroyed by resume().
+      auto* pNext = pWaiter->next_;
+      pWaiter->arg_.emplace(arg...);
+      pWaiter->handle_.resume();
+      pWaiter = pNext;
+    }
+  }
+
+  /**
+   * @brief Resume all waiting coroutines via thread pool according to its overflow policy. Resumption tasks
+   * are not droppable, so coroutines rejected by the pool are resumed in the current thread.
+   * @param arg[in] Notification argument, nothing for Event<void>.
+   */
+  template <typename... A>
+  void resume_waiters_async(const A&... arg)
+  {
+    auto* pWaiter = take_waiters();
+    if (!pWaiter) {
+      return;
+    }
+    std::vector<Task> tasks;
+    while (pWaiter) {
+      pWaiter->arg_.emplace(arg...);
+      Task task(priority_.load(std::memory_order_relaxed));
+      task.set_droppable(false);
+      task.assign_detached([handle = pWaiter->handle_] { handle.resume(); });
+      tasks.push_back(std::move(task));
+      pWaiter = pWaiter->next_;
+    }
+    thread_pool_->push_tasks_nothrow(tasks);
+  }
+
+  /**
+   * @brief Shared state of the batched async notification. It keeps a single copy of the argument
+   * and of the handler list for all chunks.
+   * @tparam A Argument types, nothing for Event<void>.
+   */
+  template <typename... A>
+  struct AsyncBatch {
+    AsyncBatch(const void* psender, const A&... arg) : psender(psender), args(arg...), remaining(0) {}
+
+    /**
+     * @brief Call handlers in range, store the first exception and complete the batch after the last chunk.
+     * @param first[in] Index of the first handler.
+     * @param last[in] Index after the last handler.
+     */
+    void run(std::size_t first, std::size_t last)
+    {
+      for (auto i = first; i < last; ++i) {
+        try {
+          std::apply([this, i](const A&... arg) { delegates[i](psender, arg...); }, args);
+        } catch (...) {
+          fail(std::current_exception());
+        }
+      }
+      complete();
+    }
+
+    /**
+     * @brief Complete the chunk which was not executed, the batch reports broken promise.
+     */
+    void cancel()
+    {
+      fail(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+      complete();
+    }
+
+    /**
+     * @brief Store the error if it is the first one.
+     * @param pError[in] Error.
+     */
+    void fail(std::exception_ptr pError)
+    {
+      std::lock_guard lock(error_mutex);
+      if (!error) {
+        error = std::move(pError);
+      }
+    }
+
+    /**
+     * @brief Complete the batch after the last chunk.
+     */
+    void complete()
+    {
+      if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        if (error) {
+          promise.set_exception(error);
+        } else {
+          promise.set_value(true);
+        }
+      }
+    }
+
+    const void* psender;
+    std::tuple<A...> args;
+    std::vector<EventDelegate<T>> delegates;
+    /**
+     * @brief Custom handlers are shared, so they stay alive if they are removed before the batch is executed.
+     */
+    std::vector<std::shared_ptr<EventHandlerImpl<T>>> owners;
+    std::atomic<std::size_t> remaining;
+    std::promise<bool> promise;
+    std::mutex error_mutex;
+    std::exception_ptr error;
+  };
+
+  /**
+   * @brief Function of the chunk task. If the task is destroyed without execution, e.g. rejected
+   * or dropped by the pool, the chunk is completed with broken promise error, so the batch result is set.
+   * @tparam A Argument types, nothing for Event<void>.
+   */
+  template <typename... A>
+  struct AsyncChunk {
+    AsyncChunk(std::shared_ptr<AsyncBatch<A...>> pBatch, std::size_t first, std::size_t last)
+      : pBatch(std::move(pBatch)), first(first), last(last)
+    {
+    }
+    AsyncChunk(AsyncChunk&&) noexcept = default;
+    AsyncChunk& operator=(AsyncChunk&&) noexcept = default;
+
+    ~AsyncChunk()
+    {
+      if (pBatch) {
+        pBatch->cancel();
+      }
+    }
+
+    void operator()() { std::exchange(pBatch, nullptr)->run(first, last); }
+
+    std::shared_ptr<AsyncBatch<A...>> pBatch;
+    std::size_t first;
+    std::size_t last;
+  };
+
+  /**
+   * @brief Split handlers into chunks and push one task per chunk to the thread pool according to its overflow policy.
+   * Chunks rejected by the pool complete the result with broken promise error.
+   * @param chunk_size[in] Number of handlers per task, 0 splits handlers evenly between pool threads.
+   * @param psender[in] Event sender.
+   * @param arg[in] Notification argument, nothing for Event<void>.
+   * @return std::future<bool> Completion of all handlers. It keeps the first exception thrown by a handler.
+   */
+  template <typename... A>
+  std::future<bool> notify_batched(std::size_t chunk_size, const void* psender, const A&... arg)
+  {
+    const TraceRecorder::Scope trace("notify_async_batched", "event");
+    auto pBatch = std::make_shared<AsyncBatch<A...>>(psender, arg...);
+    auto result = pBatch->promise.get_future();
+    {
+      const EpochDomain::Guard guard(&handlers_);
+      if (const auto* pHandlers = handlers_.load(std::memory_order_acquire)) {
+        const auto count = pHandlers->size();
+        pBatch->delegates.reserve(count);
+        pBatch->owners.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+          if (!pHandlers->is_removed(i)) {
+            pBatch->delegates.push_back(pHandlers->delegates[i]);
+            pBatch->owners.push_back(pHandlers->owners[i]);
+          }
+        }
+      }
+    }
+    const auto count = pBatch->delegates.size();
+    if (count == 0) {
+      pBatch->promise.set_value(true);
+      return result;
+    }
+    if (chunk_size == 0) {
+      const auto threads = std::max<std::size_t>(thread_pool_->get_thread_count(), 1);
+      chunk_size = (count + threads - 1) / threads;
+    }
+    const auto chunks = (count + chunk_size - 1) / chunk_size;
+    pBatch->remaining.store(chunks, std::memory_order_relaxed);
+
+    std::vector<Task> tasks;
+    tasks.reserve(chunks);
+    const auto deadline = task_deadline();
+    for (std::size_t i = 0; i < chunks; ++i) {
+      tasks.push_back(make_task(deadline));
+      tasks[i].assign_detached(AsyncChunk<A...>(pBatch, i * chunk_size, std::min(count, (i + 1) * chunk_size)));
+    }
+    thread_pool_->push_tasks_nothrow(tasks);
+    return result;
+  }
+
+private:
+  /**
+   * @brief Subscription slot. Generation is incremented when the slot is released,
+   * so tokens of removed subscriptions do not match the reused slot.
+   */
+  struct Slot {
+    std::uint32_t generation = 0;
+    std::uint32_t position = 0;
+    bool used = false;
+  };
+
+  /**
+   * @brief Subscription owner passed to tokens. Tokens may be disconnected in other threads while the event
+   * is destroyed, so the event is detached from the source under the lock taken by every disconnect.
+   * Disconnects share the lock, so they do not wait for each other, e.g. when a handler disconnects
+   * a token while another thread waits for the notification in unsubscribe().
+   */
+  class Source : public SubscriptionSource {
+  public:
+    explicit Source(EventBase<T>* pEvent) : pEvent_(pEvent) {}
+
+    virtual void Disconnect(std::uint32_t slot, std::uint32_t generation) override
+    {
+      std::shared_lock lock(mutex_);
+      if (pEvent_) {
+        pEvent_->unsubscribe(slot, generation);
+      }
+    }
+
+    /**
+     * @brief Wait for running disconnects and make later ones do nothing. Called by the event destructor.
+     */
+    void Detach()
+    {
+      std::unique_lock lock(mutex_);
+      pEvent_ = nullptr;
+    }
+
+  private:
+    std::shared_mutex mutex_;
+    /**
+     * @brief Event owning the subscriptions, nullptr after the event is destroyed.
+     */
+    EventBase<T>* pEvent_;
+  };
+
+  static constexpr std::uint32_t npos = static_cast<std::uint32_t>(-1);
+
+  /**
+   * @brief Min capacity of the snapshot.
+   */
+  static constexpr std::size_t min_capacity = 4;
+
+  /**
+   * @brief Remove the subscription by slot index if the generation matches.
+   * @param slot[in] Slot index.
+   * @param generation[in] Slot generation.
+   */
+  void unsubscribe(std::uint32_t slot, std::uint32_t generation)
+  {
+    const HandlerList* pOldHandlers = nullptr;
+    std::shared_ptr<EventHandlerImpl<T>> pOwner;
+    {
+      std::lock_guard lock(mutex_);
+      if (slot >= slots_.size() || !slots_[slot].used || slots_[slot].generation != generation) {
+        return;
+      }
+      pOldHandlers = erase(slot, pOwner);
+    }
+    EpochDomain::instance().synchronize(&handlers_);
+    EpochDomain::instance().retire(pOldHandlers);
+    if (pOwner) {
+      pOwner->OnUnsubscribed();
+    }
+  }
+
+  /**
+   * @brief Take free slot. Must be called under mutex_.
+   * @return std::uint32_t Slot index.
+   */
+  std::uint32_t acquire_slot()
+  {
+    std::uint32_t slot;
+    if (free_slots_.empty()) {
+      slot = static_cast<std::uint32_t>(slots_.size());
+      slots_.emplace_back();
+    } else {
+      slot = free_slots_.back();
+      free_slots_.pop_back();
+    }
+    slots_[slot].used = true;
+    return slot;
+  }
+
+  /**
+   * @brief Mark the entry of the subscription as removed. When half of the entries are removed, live entries
+   * are copied to a new snapshot in the same order, so removal takes amortized constant time.
+   * Removed custom handlers are released with the replaced snapshot. Must be called under mutex_.
+   * OnUnsubscribed() of the removed custom handler is called by the caller after unlocking, so the subscription
+   * is removed even if it throws, and the handler may remove other subscriptions from it.
+   * @param slot[in] Slot index.
+   * @param pOwner[out] Removed custom handler, empty for other handlers.
+   * @return const HandlerList* Replaced snapshot to be retired, nullptr if the snapshot was kept.
+   */
+  const HandlerList* erase(std::uint32_t slot, std::shared_ptr<EventHandlerImpl<T>>& pOwner)
+  {
+    free_slots_.push_back(slot);
+    auto* pHandlers = handlers_.load(std::memory_order_relaxed);
+    const auto position = slots_[slot].position;
+    pOwner = pHandlers->owners[position];
+    if (pOwner) {
+      custom_index_.erase(custom_key(pOwner.get()));
+    } else {
+      index_.erase(pHandlers->delegates[position]);
+    }
+    pHandlers->removed[position].store(true, std::memory_order_seq_cst);
+    slots_[slot].used = false;
+    ++slots_[slot].generation;
+    if (++removed_count_ * 2 < pHandlers->size()) {
+      return nullptr;
+    }
+    return handlers_.exchange(compact(pHandlers).release(), std::memory_order_seq_cst);
+  }
+
+  /**
+   * @brief Copy live entries of the snapshot to a new one with room for as many more and update their positions.
+   * Must be called under mutex_.
+   * @param pHandlers[in] Current snapshot, nullptr if there is no snapshot yet.
+   * @return std::unique_ptr<HandlerList> New snapshot.
+   */
+  std::unique_ptr<HandlerList> compact(const HandlerList* pHandlers)
+  {
+    const auto count = pHandlers ? pHandlers->size() : 0;
+    auto pNewHandlers = std::make_unique<HandlerList>(std::max(2 * (count - removed_count_), min_capacity));
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      if (pHandlers->is_removed(i)) {
+        continue;
+      }
+      pNewHandlers->delegates[size] = pHandlers->delegates[i];
+      pNewHandlers->owners[size] = pHandlers->owners[i];
+      pNewHandlers->keys[size] = pHandlers->keys[i];
+      pNewHandlers->counters[size] = pHandlers->counters[i];
+      positions_[size] = positions_[i];
+      slots_[positions_[size]].position = static_cast<std::uint32_t>(size);
+      ++size;
+    }
+    if (pHandlers) {
+      pNewHandlers->instrumentation = pHandlers->instrumentation;
+    }
+    positions_.resize(size);
+    pNewHandlers->count.store(size, std::memory_order_relaxed);
+    removed_count_ = 0;
+    return pNewHandlers;
+  }
+
+  /**
+   * @brief Publish snapshot with changed instrumentation settings. Handlers get dispatch counters
+   * if counters are enabled.
+   * @param update[in] Function object changing the settings.
+   */
+  template <typename F>
+  void update_instrumentation(F&& update)
+  {
+    const HandlerList* pOldHandlers = nullptr;
+    {
+      std::lock_guard lock(mutex_);
+      auto pNewHandlers = compact(handlers_.load(std::memory_order_relaxed));
+      auto instrumentation = pNewHandlers->instrumentation ? *pNewHandlers->instrumentation : Instrumentation{};
+      update(instrumentation);
+      if (instrumentation.stats) {
+        for (std::size_t i = 0, count = pNewHandlers->size(); i < count; ++i) {
+          if (!pNewHandlers->counters[i]) {
+            pNewHandlers->counters[i] = std::make_shared<EventDispatchCounters>();
+          }
+        }
+      }
+      pNewHandlers->instrumentation = instrumentation.stats || instrumentation.callback
+                                        ? std::make_shared<const Instrumentation>(std::move(instrumentation))
+                                        : nullptr;
+      pOldHandlers = handlers_.exchange(pNewHandlers.release(), std::memory_order_seq_cst);
+    }
+    EpochDomain::instance().retire(pOldHandlers);
+  }
+
+  /**
+   * @brief Return identity of the custom handler in custom_index_. Handlers without key match only themselves,
+   * so they are identified by address.
+   * @param pHandler[in] Custom handler.
+   * @return EventHandlerKey Key.
+   */
+  static EventHandlerKey custom_key(const EventHandlerImpl<T>* pHandler)
+  {
+    if (pHandler->Key().type) {
+      return pHandler->Key();
+    }
+    EventHandlerKey key;
+    key.object = pHandler;
+    return key;
+  }
+
+  /**
+   * @brief Append waiter to the list.
+   * @param pWaiter[in] Waiter.
+   */
+  void add_waiter(EventAwaiter<T>* pWaiter)
+  {
+    const std::lock_guard lock(waiters_mutex_);
+    if (waiters_tail_) {
+      waiters_tail_->next_ = pWaiter;
+    } else {
+      waiters_head_.store(pWaiter, std::memory_order_release);
+    }
+    waiters_tail_ = pWaiter;
+  }
+
+  /**
+   * @brief Detach all waiters from the event.
+   * @return EventAwaiter<T>* The first waiter of the detached list.
+   */
+  EventAwaiter<T>* take_waiters()
+  {
+    // Notification does not touch the mutex if there are no waiters.
+    if (!waiters_head_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    const std::lock_guard lock(waiters_mutex_);
+    auto* pWaiter = waiters_head_.exchange(nullptr, std::memory_order_relaxed);
+    waiters_tail_ = nullptr;
+    return pWaiter;
+  }
 
 protected:
-  std::vector<EventHandlerImplPtr<T>> handlers_;
-  std::shared_mutex mutex_;
+  /**
+   * @brief Current snapshot of observers, nullptr if there were no observers yet.
+   * Must be read inside EpochDomain::Guard read section with the address of this member as scope.
+   */
+  std::atomic<HandlerList*> handlers_ = nullptr;
+  /**
+   * @brief Mutex serializing adding/removing operations.
+   */
+  std::mutex mutex_;
+
+private:
+  /**
+   * @brief Subscription slots, guarded by mutex_.
+   */
+  std::vector<Slot> slots_;
+  /**
+   * @brief Indices of released slots, guarded by mutex_.
+   */
+  std::vector<std::uint32_t> free_slots_;
+  /**
+   * @brief Slot index of every snapshot entry, guarded by mutex_.
+   */
+  std::vector<std::uint32_t> positions_;
+  /**
+   * @brief Number of removed entries of the current snapshot, guarded by mutex_.
+   */
+  std::size_t removed_count_ = 0;
+  /**
+   * @brief Slot index by delegate identity for duplicate checks, guarded by mutex_.
+   * Custom handlers are not indexed.
+   */
+  std::unordered_map<EventDelegate<T>, std::uint32_t> index_;
+  /**
+   * @brief Slot index of custom handlers by their key, guarded by mutex_.
+   */
+  std::unordered_map<EventHandlerKey, std::uint32_t> custom_index_;
+  /**
+   * @brief Subscription owner referenced by tokens, guarded by mutex_.
+   */
+  std::shared_ptr<Source> source_;
+  /**
+   * @brief Priority of async notification tasks.
+   */
+  std::atomic<TaskPriority> priority_ = TaskPriority::Medium;
+  /**
+   * @brief Relative deadline of async notification tasks, 0 if it is disabled.
+   */
+  std::atomic<std::chrono::nanoseconds> deadline_ = std::chrono::nanoseconds(0);
+  /**
+   * @brief Dispatch counters of notify() calls.
+   */
+  EventDispatchCounters dispatch_counters_;
+  std::atomic<EventAwaiter<T>*> waiters_head_ = nullptr;
+  EventAwaiter<T>* waiters_tail_ = nullptr;
+  std::mutex waiters_mutex_;
 };
 }  // namespace core
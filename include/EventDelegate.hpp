@@ -0,0 +1,200 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+namespace core {
+
+template <typename T>
+class EventDelegate;
+
+/**
+ * @brief Signature of the delegate thunk for the event argument type.
+ * @tparam T Argument type.
+ */
+template <typename T>
+struct EventDelegateThunk {
+  using type = void (*)(const EventDelegate<T>&, const void*, const T&);
+};
+
+/**
+ * @brief Signature of the delegate thunk for events without argument.
+ */
+template <>
+struct EventDelegateThunk<void> {
+  using type = void (*)(const EventDelegate<void>&, const void*);
+};
+
+/**
+ * @brief This class implement fixed-size trivially copyable delegate to a function or class method
+ * handling an event. It keeps pointer to the object, function pointer bytes and pointer to the thunk
+ * which restores the function type and makes the call, so delegates are stored by value
+ * and dispatching does not chase pointers to separately allocated handler objects.
+ * @tparam T Argument type.
+ */
+template <typename T>
+class EventDelegate {
+public:
+  using Thunk = typename EventDelegateThunk<T>::type;
+
+  /**
+   * @brief Max size of the stored function pointer. Pointers to member functions of classes
+   * with single or multiple inheritance fit it.
+   */
+  static constexpr std::size_t function_size = 2 * sizeof(void*);
+
+  /**
+   * @brief Construct a new empty EventDelegate object.
+   */
+  constexpr EventDelegate() noexcept : object_(nullptr), thunk_(nullptr), function_{} {}
+
+  /**
+   * @brief Create delegate to the function.
+   * @tparam F Function pointer type.
+   * @param pFunction[in] Function pointer, empty delegate is returned for nullptr.
+   * @return EventDelegate Delegate.
+   */
+  template <typename F, typename = std::enable_if_t<std::is_pointer_v<F>>>
+  static EventDelegate bind(F pFunction)
+  {
+    EventDelegate delegate;
+    if (pFunction) {
+      delegate.store(pFunction);
+      delegate.thunk_ = &invoke_function<F>;
+    }
+    return delegate;
+  }
+
+  /**
+   * @brief Create delegate to the class method.
+   * @tparam U Class type.
+   * @tparam F Member function pointer type.
+   * @param thisPtr[in] Object pointer.
+   * @param pMemberFunction[in] Member function pointer. Empty delegate is returned if any pointer is nullptr.
+   * @return EventDelegate Delegate.
+   */
+  template <typename U, typename F, typename = std::enable_if_t<std::is_member_function_pointer_v<F>>>
+  static EventDelegate bind(U* thisPtr, F pMemberFunction)
+  {
+    EventDelegate delegate;
+    if (thisPtr && pMemberFunction) {
+      delegate.object_ = const_cast<void*>(static_cast<const void*>(thisPtr));
+      delegate.store(pMemberFunction);
+      delegate.thunk_ = &invoke_member<U, F>;
+    }
+    return delegate;
+  }
+
+  /**
+   * @brief Call the bound function.
+   * @param psender[in] Pointer to the sender.
+   * @param arg[in] Passed argument.
+   */
+  template <typename A = T, typename = std::enable_if_t<!std::is_void_v<A>>>
+  void operator()(const void* psender, const A& arg) const
+  {
+    thunk_(*this, psender, arg);
+  }
+
+  /**
+   * @brief Call the bound function.
+   * @param psender[in] Pointer to the sender.
+   */
+  template <typename A = T, typename = std::enable_if_t<std::is_void_v<A>>>
+  void operator()(const void* psender) const
+  {
+    thunk_(*this, psender);
+  }
+
+  /**
+   * @brief Checks if the delegate is bound.
+   */
+  explicit operator bool() const noexcept { return thunk_ != nullptr; }
+
+  /**
+   * @brief Return pointer to the bound object, nullptr for functions.
+   * @return const void* Object pointer.
+   */
+  const void* object() const noexcept { return object_; }
+
+  /**
+   * @brief Checks that delegates are bound to the same object and function of the same type.
+   */
+  friend bool operator==(const EventDelegate& lhs, const EventDelegate& rhs) noexcept
+  {
+    return lhs.object_ == rhs.object_ && lhs.thunk_ == rhs.thunk_ &&
+           std::memcmp(lhs.function_, rhs.function_, function_size) == 0;
+  }
+
+  /**
+   * @brief Return hash of the bound object and function identity.
+   * @return std::size_t Hash value.
+   */
+  std::size_t hash() const noexcept
+  {
+    std::uintptr_t words[function_size / sizeof(std::uintptr_t)];
+    std::memcpy(words, function_, function_size);
+    auto value = std::hash<const void*>{}(object_);
+    const auto combine = [&value](std::size_t word) {
+      value ^= word + static_cast<std::size_t>(0x9e3779b97f4a7c15ull) + (value << 6) + (value >> 2);
+    };
+    combine(reinterpret_cast<std::uintptr_t>(thunk_));
+    for (const auto word : words) {
+      combine(word);
+    }
+    return value;
+  }
+
+private:
+  template <typename F>
+  void store(F pFunction)
+  {
+    static_assert(sizeof(F) <= function_size, "Function pointer does not fit the delegate");
+    std::memcpy(function_, &pFunction, sizeof(F));
+  }
+
+  template <typename F>
+  F load() const
+  {
+    F pFunction;
+    std::memcpy(&pFunction, function_, sizeof(F));
+    return pFunction;
+  }
+
+  template <typename F, typename... A>
+  static void invoke_function(const EventDelegate& delegate, const void* psender, const A&... arg)
+  {
+    delegate.load<F>()(psender, arg...);
+  }
+
+  template <typename U, typename F, typename... A>
+  static void invoke_member(const EventDelegate& delegate, const void* psender, const A&... arg)
+  {
+    (static_cast<U*>(delegate.object_)->*(delegate.load<F>()))(psender, arg...);
+  }
+
+  /**
+   * @brief Pointer to the bound object, nullptr for functions.
+   */
+  void* object_;
+  /**
+   * @brief Function restoring the function type and making the call.
+   */
+  Thunk thunk_;
+  /**
+   * @brief Bytes of the bound function pointer.
+   */
+  alignas(void*) unsigned char function_[function_size];
+};
+}  // namespace core
+
+/**
+ * @brief Hash of the delegate identity for unordered containers.
+ */
+template <typename T>
+struct std::hash<core::EventDelegate<T>> {
+  std::size_t operator()(const core::EventDelegate<T>& delegate) const noexcept { return delegate.hash(); }
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "EventHandlerImplBase.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace core {
+
+/**
+ * @brief Dispatch counters of an event or of one of its handlers.
+ */
+struct EventDispatchStats {
+  /**
+   * @brief Number of calls.
+   */
+  std::uint64_t invocations = 0;
+  /**
+   * @brief Number of calls which threw an exception.
+   */
+  std::uint64_t exceptions = 0;
+  /**
+   * @brief Total duration of the calls.
+   */
+  std::chrono::nanoseconds total_latency{0};
+  /**
+   * @brief Duration of the longest call.
+   */
+  std::chrono::nanoseconds max_latency{0};
+};
+
+/**
+ * @brief Callback reporting a handler call which exceeded the budget.
+ * The handler is identified by the key computed at bind time, see EventHandlerImplBase::Key().
+ * The callback is called in the notifying thread after the handler returns, it must not throw.
+ */
+using SlowHandlerCallback = std::function<void(const EventHandlerKey& key, std::chrono::nanoseconds latency)>;
+
+/**
+ * @brief This class represent dispatch counters updated concurrently by notifying threads.
+ */
+class EventDispatchCounters {
+public:
+  /**
+   * @brief Record the call.
+   * @param latency[in] Call duration.
+   * @param failed[in] True if the call threw an exception.
+   */
+  void record(std::chrono::nanoseconds latency, bool failed)
+  {
+    const auto ns = static_cast<std::uint64_t>(latency.count());
+    invocations_.fetch_add(1, std::memory_order_relaxed);
+    if (failed) {
+      exceptions_.fetch_add(1, std::memory_order_relaxed);
+    }
+    total_latency_.fetch_add(ns, std::memory_order_relaxed);
+    auto max = max_latency_.load(std::memory_order_relaxed);
+    while (ns > max && !max_latency_.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+    }
+  }
+
+  /**
+   * @brief Copy the counters. Counters updated during the copy may be partially included.
+   * @return EventDispatchStats Counters.
+   */
+  EventDispatchStats stats() const
+  {
+    EventDispatchStats stats;
+    stats.invocations = invocations_.load(std::memory_order_relaxed);
+    stats.exceptions = exceptions_.load(std::memory_order_relaxed);
+    stats.total_latency = std::chrono::nanoseconds(total_latency_.load(std::memory_order_relaxed));
+    stats.max_latency = std::chrono::nanoseconds(max_latency_.load(std::memory_order_relaxed));
+    return stats;
+  }
+
+private:
+  std::atomic<std::uint64_t> invocations_ = 0;
+  std::atomic<std::uint64_t> exceptions_ = 0;
+  std::atomic<std::uint64_t> total_latency_ = 0;
+  std::atomic<std::uint64_t> max_latency_ = 0;
+};
+}  // namespace core
@@ -42,6 +42,34 @@ public:
     return std::make_unique<EventHandlerImplForMemberFunction<U, T>>(thisPtr, pMemberFunction);
   }
 
+  /**
+   * @brief This method creates event handler pointer corresponding
+   * to function acquired const void* type to sender and reference to template argument.
+   * The argument is passed to the function without copying.
+   * @tparam T Template argument type.
+   * @param pFunction[in] Function(event handler) pointer.
+   * @return EventHandlerImplPtr<T> Return unique pointer to event handler base.
+   */
+  template <typename T>
+  static EventHandlerImplPtr<T> bind(void (*pFunction)(const void*, const T&))
+  {
+    return std::make_unique<EventHandlerImplForNonMemberFunction<T, const T&>>(pFunction);
+  }
+
+  /**
+   * @brief This method creates event handler pointer corresponding
+   * to class method acquired const void* type to sender and reference to template argument.
+   * The argument is passed to the method without copying.
+   * @tparam T Template argument type.
+   * @param pMemberFunction[in] Member function(event handler) pointer.
+   * @return EventHandlerImplPtr<T> Return unique pointer to event handler base.
+   */
+  template <typename U, typename T>
+  static EventHandlerImplPtr<T> bind(U* thisPtr, void (U::*pMemberFunction)(const void*, const T&))
+  {
+    return std::make_unique<EventHandlerImplForMemberFunction<U, T, const T&>>(thisPtr, pMemberFunction);
+  }
+
   /**
    * @brief This method creates event handler pointer corresponding
    * to function acquired const void* type to sender.
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "EventDelegate.hpp"
 #include "EventHandlerImplBase.hpp"
 
 #include <utility>
@@ -22,6 +23,8 @@ using EventHandlerImplPtr = std::unique_ptr<EventHandlerImpl<T>>;
 template <typename T>
 class EventHandlerImpl : public EventHandlerImplBase<T> {
 public:
+  using EventHandlerImplBase<T>::EventHandlerImplBase;
+
   /**
    * @brief Implement this method to notify subscribers synchronously.
    * The method takes a pointer to the sender and a passed argument.
@@ -29,6 +32,13 @@ public:
    * @param[in] arg Passed argument.
    */
   virtual void OnEvent(const void* psender, const T& arg) = 0;
+
+  /**
+   * @brief Create delegate which is stored by the event instead of the handler.
+   * By default the delegate calls OnEvent() of this handler, so the event keeps the handler alive.
+   * @return EventDelegate<T> Delegate.
+   */
+  virtual EventDelegate<T> ToDelegate() { return EventDelegate<T>::bind(this, &EventHandlerImpl<T>::OnEvent); }
 };
 
 /**
@@ -37,20 +47,30 @@ public:
 template <>
 class EventHandlerImpl<void> : public EventHandlerImplBase<void> {
 public:
+  using EventHandlerImplBase<void>::EventHandlerImplBase;
+
   /**
    * @brief Implement this method to notify subscribers synchronously.
    * The method takes a pointer to the sender.
    * @param[in] psender Pointer to the sender.
    */
   virtual void OnEvent(const void* psender) = 0;
+
+  /**
+   * @brief Create delegate which is stored by the event instead of the handler.
+   * By default the delegate calls OnEvent() of this handler, so the event keeps the handler alive.
+   * @return EventDelegate<void> Delegate.
+   */
+  virtual EventDelegate<void> ToDelegate() { return EventDelegate<void>::bind(this, &EventHandlerImpl<void>::OnEvent); }
 };
 
 /**
  * @brief Event handler for a function that takes a pointer
  * to the sender object and an argument of type T.
  * @tparam T Argument type.
+ * @tparam P Parameter type of the function, T or const T&.
  */
-template <typename T>
+template <typename T, typename P = T>
 class EventHandlerImplForNonMemberFunction : public EventHandlerImpl<T> {
 public:
   /**
@@ -58,7 +78,11 @@ public:
    * @param[in] pFunction Function pointer that takes a pointer
    * to the sender object and an argument of type T
    */
-  EventHandlerImplForNonMemberFunction(void (*pFunction)(const void*, T)) : pFunction_(pFunction) {}
+  EventHandlerImplForNonMemberFunction(void (*pFunction)(const void*, P))
+    : EventHandlerImpl<T>(EventHandlerKey::make<EventHandlerImplForNonMemberFunction<T, P>>(nullptr, pFunction)),
+      pFunction_(pFunction)
+  {
+  }
 
   /**
    * @brief Call handler via pointer to function.
@@ -75,29 +99,27 @@ public:
 
   /**
    * @brief Сhecks the current and passed event handler.
-   * Checks the type of the passed event handler with the current one.
-   * Performs function check pointer handlers.
+   * Compares keys of the handlers computed at construction.
    * @param[in] pHandler2 Pointer to the event handler.
    * @return true If handlers are same type and have same function pointer.
    * @return false Otherwise
    */
   virtual bool IsBindedToSameFunctionAs(const EventHandlerImplBase<T>* pHandler) const override final
   {
-    if (!EventHandlerImplBase<T>::IsSametype(pHandler)) {
-      return false;
-    }
-    const auto pHandlerCasted = dynamic_cast<const EventHandlerImplForNonMemberFunction<T>*>(pHandler);
-    if (!pHandlerCasted) {
-      return false;
-    }
-    return this->pFunction_ == pHandlerCasted->pFunction_;
+    return pHandler && this->Key() == pHandler->Key();
   }
 
+  /**
+   * @brief Create delegate calling the bound function directly, without the handler object.
+   * @return EventDelegate<T> Delegate.
+   */
+  virtual EventDelegate<T> ToDelegate() override final { return EventDelegate<T>::bind(pFunction_); }
+
 private:
   /**
    * @brief Pointer to a function for event handling.
    */
-  void (*pFunction_)(const void*, T);
+  void (*pFunction_)(const void*, P);
 };
 
 /**
@@ -105,8 +127,9 @@ private:
  * to the sender object and an argument of type T.
  * @tparam U Class name.
  * @tparam T Argument type.
+ * @tparam P Parameter type of the method, T or const T&.
  */
-template <typename U, typename T>
+template <typename U, typename T, typename P = T>
 class EventHandlerImplForMemberFunction : public EventHandlerImpl<T> {
 public:
   /**
@@ -115,8 +138,10 @@ public:
    * @param[in] pMemberFunction Function pointer that takes a pointer
    * to the sender object and an argument of type T.
    */
-  EventHandlerImplForMemberFunction(U* thisPtr, void (U::*pMemberFunction)(const void*, T))
-    : pCaller_(thisPtr), pMemberFunction_(pMemberFunction)
+  EventHandlerImplForMemberFunction(U* thisPtr, void (U::*pMemberFunction)(const void*, P))
+    : EventHandlerImpl<T>(EventHandlerKey::make<EventHandlerImplForMemberFunction<U, T, P>>(thisPtr, pMemberFunction)),
+      pCaller_(thisPtr),
+      pMemberFunction_(pMemberFunction)
   {
   }
 
@@ -135,24 +160,22 @@ public:
 
   /**
    * @brief Сhecks the current and passed event handler.
-   * Checks the type of the passed event handler with the current one.
-   * Checks pointers to objects and member functions.
+   * Compares keys of the handlers computed at construction.
    * @param[in] pHandler2 Pointer to the event handler.
    * @return true If handlers are same type and have same object and method pointers.
    * @return false Otherwise
    */
   virtual bool IsBindedToSameFunctionAs(const EventHandlerImplBase<T>* pHandler) const override final
   {
-    if (!EventHandlerImplBase<T>::IsSametype(pHandler)) {
-      return false;
-    }
-    const auto pHandlerCasted = dynamic_cast<const EventHandlerImplForMemberFunction<U, T>*>(pHandler);
-    if (!pHandlerCasted) {
-      return false;
-    }
-    return this->pCaller_ == pHandlerCasted->pCaller_ && this->pMemberFunction_ == pHandlerCasted->pMemberFunction_;
+    return pHandler && this->Key() == pHandler->Key();
   }
 
+  /**
+   * @brief Create delegate calling the bound function directly, without the handler object.
+   * @return EventDelegate<T> Delegate.
+   */
+  virtual EventDelegate<T> ToDelegate() override final { return EventDelegate<T>::bind(pCaller_, pMemberFunction_); }
+
 private:
   /**
    * @brief Pointer to object.
@@ -161,7 +184,7 @@ private:
   /**
    * @brief Pointer to class method for event handling.
    */
-  void (U::*pMemberFunction_)(const void*, T);
+  void (U::*pMemberFunction_)(const void*, P);
 };
 
 /**
@@ -175,7 +198,11 @@ public:
    * @brief Construct a new EventHandlerImplForNonMemberFunction object.
    * @param[in] pFunction Function pointer that takes a pointer to the sender object.
    */
-  EventHandlerImplForNonMemberFunction(void (*pFunction)(const void*)) : pFunction_(pFunction) {}
+  EventHandlerImplForNonMemberFunction(void (*pFunction)(const void*))
+    : EventHandlerImpl<void>(EventHandlerKey::make<EventHandlerImplForNonMemberFunction<void>>(nullptr, pFunction)),
+      pFunction_(pFunction)
+  {
+  }
 
   /**
    * @brief Call handler via pointer to function.
@@ -191,25 +218,22 @@ public:
 
   /**
    * @brief Сhecks the current and passed event handler.
-   * Checks the type of the passed event handler with the current one.
-   * Performs function check pointer handlers.
+   * Compares keys of the handlers computed at construction.
    * @param[in] pHandler2 Pointer to the event handler.
    * @return true If handlers are same type and have same function pointer.
    * @return false Otherwise.
    */
   virtual bool IsBindedToSameFunctionAs(const EventHandlerImplBase<void>* pHandler) const override final
   {
-    if (!IsSametype(pHandler)) {
-      return false;
-    }
-    const auto pHandlerCasted = dynamic_cast<const EventHandlerImplForNonMemberFunction<void>*>(pHandler);
-    if (!pHandlerCasted) {
-      return false;
-    }
-
-    return this->pFunction_ == pHandlerCasted->pFunction_;
+    return pHandler && this->Key() == pHandler->Key();
   }
 
+  /**
+   * @brief Create delegate calling the bound function directly, without the handler object.
+   * @return EventDelegate<void> Delegate.
+   */
+  virtual EventDelegate<void> ToDelegate() override final { return EventDelegate<void>::bind(pFunction_); }
+
 private:
   /**
    * @brief Pointer to a function for event handling.
@@ -231,7 +255,9 @@ public:
    * @param[in] pMemberFunction Function pointer that takes a pointer to the sender object.
    */
   EventHandlerImplForMemberFunction(U* thisPtr, void (U::*pMemberFunction)(const void*))
-    : pCaller_(thisPtr), pMemberFunction_(pMemberFunction)
+    : EventHandlerImpl<void>(EventHandlerKey::make<EventHandlerImplForMemberFunction<U, void>>(thisPtr, pMemberFunction)),
+      pCaller_(thisPtr),
+      pMemberFunction_(pMemberFunction)
   {
   }
 
@@ -249,25 +275,22 @@ public:
 
   /**
    * @brief Сhecks the current and passed event handler.
-   * Checks the type of the passed event handler with the current one.
-   * Checks pointers to objects and member functions.
+   * Compares keys of the handlers computed at construction.
    * @param[in] pHandler2 Pointer to the event handler.
    * @return true If handlers are same type and have same object and method pointers.
    * @return false Otherwise
    */
   virtual bool IsBindedToSameFunctionAs(const EventHandlerImplBase<void>* pHandler) const override final
   {
-    if (!IsSametype(pHandler)) {
-      return false;
-    }
-
-    const auto pHandlerCasted = dynamic_cast<const EventHandlerImplForMemberFunction<U, void>*>(pHandler);
-    if (!pHandlerCasted) {
-      return false;
-    }
-    return this->pCaller_ == pHandlerCasted->pCaller_ && this->pMemberFunction_ == pHandlerCasted->pMemberFunction_;
+    return pHandler && this->Key() == pHandler->Key();
   }
 
+  /**
+   * @brief Create delegate calling the bound function directly, without the handler object.
+   * @return EventDelegate<void> Delegate.
+   */
+  virtual EventDelegate<void> ToDelegate() override final { return EventDelegate<void>::bind(pCaller_, pMemberFunction_); }
+
 private:
   /**
    * @brief Pointer to object.
@@ -279,4 +302,22 @@ private:
   void (U::*pMemberFunction_)(const void*);
 };
 
+/**
+ * @brief Create key of the handler wrapping another one from the key of the wrapped handler.
+ * Wrappers of handlers without key are identified by the wrapped handler address.
+ * @tparam Handler Wrapper handler type.
+ * @tparam T Argument type.
+ * @param handler[in] Wrapped handler.
+ * @return EventHandlerKey Key.
+ */
+template <typename Handler, typename T>
+EventHandlerKey MakeWrappedEventHandlerKey(const EventHandlerImpl<T>& handler)
+{
+  if (!handler.Key().type) {
+    return EventHandlerKey::make<Handler>(&handler);
+  }
+  auto key = handler.Key();
+  key.type = &event_handler_type_tag<Handler>;
+  return key;
+}
 }  // namespace core
@@ -1,8 +1,104 @@
 #pragma once
 
-#include <typeinfo>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 
 namespace core {
+
+/**
+ * @brief Unique object per handler type, its address identifies the type without RTTI.
+ * @tparam Handler Handler type.
+ */
+template <typename Handler>
+inline constexpr char event_handler_type_tag = 0;
+
+/**
+ * @brief This class implement compact identity of the event handler computed at bind time.
+ * It keeps the handler type tag, pointer to the bound object and bytes of the bound function pointer,
+ * so handlers are compared by plain bytes compare.
+ */
+struct EventHandlerKey {
+  /**
+   * @brief Max size of the stored function pointer.
+   */
+  static constexpr std::size_t function_size = 2 * sizeof(void*);
+
+  /**
+   * @brief Create key of the handler type bound to the object.
+   * @tparam Handler Handler type.
+   * @param object[in] Pointer to the bound object or other data identifying the handler.
+   * @return EventHandlerKey Key.
+   */
+  template <typename Handler>
+  static EventHandlerKey make(const void* object = nullptr) noexcept
+  {
+    EventHandlerKey key;
+    key.type = &event_handler_type_tag<Handler>;
+    key.object = object;
+    return key;
+  }
+
+  /**
+   * @brief Create key of the handler type bound to the object and function.
+   * @tparam Handler Handler type.
+   * @tparam F Function or member function pointer type.
+   * @param object[in] Pointer to the bound object, nullptr for functions.
+   * @param pFunction[in] Bound function pointer.
+   * @return EventHandlerKey Key.
+   */
+  template <typename Handler, typename F>
+  static EventHandlerKey make(const void* object, F pFunction) noexcept
+  {
+    static_assert(sizeof(F) <= function_size, "Function pointer does not fit the key");
+    auto key = make<Handler>(object);
+    std::memcpy(key.function, &pFunction, sizeof(F));
+    return key;
+  }
+
+  /**
+   * @brief Checks that keys are of the same handler type bound to the same object and function.
+   */
+  friend bool operator==(const EventHandlerKey& lhs, const EventHandlerKey& rhs) noexcept
+  {
+    return lhs.type == rhs.type && lhs.object == rhs.object &&
+           std::memcmp(lhs.function, rhs.function, function_size) == 0;
+  }
+
+  /**
+   * @brief Return hash of the handler type, bound object and function.
+   * @return std::size_t Hash value.
+   */
+  std::size_t hash() const noexcept
+  {
+    std::uintptr_t words[function_size / sizeof(std::uintptr_t)];
+    std::memcpy(words, function, function_size);
+    auto value = std::hash<const void*>{}(object);
+    const auto combine = [&value](std::size_t word) {
+      value ^= word + static_cast<std::size_t>(0x9e3779b97f4a7c15ull) + (value << 6) + (value >> 2);
+    };
+    combine(reinterpret_cast<std::uintptr_t>(type));
+    for (const auto word : words) {
+      combine(word);
+    }
+    return value;
+  }
+
+  /**
+   * @brief Handler type tag, nullptr if the handler has no key.
+   */
+  const void* type = nullptr;
+  /**
+   * @brief Pointer to the bound object.
+   */
+  const void* object = nullptr;
+  /**
+   * @brief Bytes of the bound function pointer.
+   */
+  alignas(void*) unsigned char function[function_size] = {};
+};
+
 /**
  * @brief This class contains some check functions for primary verification
  * using event model.
@@ -25,19 +121,59 @@ public:
    */
   virtual bool IsBindedToSameFunctionAs(const EventHandlerImplBase<T>* pHandler) const = 0;
 
+  /**
+   * @brief Called by the event when the subscription of the handler is removed or the event is destroyed.
+   * Notifications running in other threads may still call the handler, so handlers delivering
+   * notifications later, e.g. via a queue, must stop delivery here. Does nothing by default.
+   */
+  virtual void OnUnsubscribed() {}
+
   /**
    * @brief Checks the type of the current handler with the one passed.
    * This check must be included in the IsBindedToSameFunctionAs method.
+   * Handlers constructed without key are of the same type only with themselves.
    * @param EventHandlerImplBase<T>* Pointer to passed handler
    * @return true If types are matched
    * @return false Otherwise
    */
   bool IsSametype(const EventHandlerImplBase<T>* pHandler) const
   {
-    if (!pHandler || typeid(*this) != typeid(*pHandler)) {
+    if (!pHandler) {
       return false;
     }
-    return true;
+    return pHandler == this || (key_.type && key_.type == pHandler->key_.type);
   }
+
+  /**
+   * @brief Return identity of the handler computed at bind time.
+   * @return const EventHandlerKey& Key.
+   */
+  const EventHandlerKey& Key() const noexcept { return key_; }
+
+protected:
+  /**
+   * @brief Construct a new EventHandlerImplBase object without key.
+   */
+  EventHandlerImplBase() = default;
+
+  /**
+   * @brief Construct a new EventHandlerImplBase object.
+   * @param key[in] Identity of the handler.
+   */
+  explicit EventHandlerImplBase(const EventHandlerKey& key) : key_(key) {}
+
+private:
+  /**
+   * @brief Identity of the handler.
+   */
+  EventHandlerKey key_;
 };
 }  // namespace core
+
+/**
+ * @brief Hash of the handler key for unordered containers.
+ */
+template <>
+struct std::hash<core::EventHandlerKey> {
+  std::size_t operator()(const core::EventHandlerKey& key) const noexcept { return key.hash(); }
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "TaskFunction.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace core {
+
+/**
+ * @brief This class represent inbox of messages executed by a consumer thread.
+ * Any thread may post messages, the consumer thread executes them by run_once() or run().
+ * Events deliver notifications of queued subscriptions through the loop, so handlers of
+ * single-threaded components are always called by the same thread.
+ */
+class EventLoop {
+public:
+  using SharedPtr = std::shared_ptr<EventLoop>;
+
+  /**
+   * @brief Construct a new EventLoop object.
+   */
+  EventLoop();
+
+  /**
+   * @brief Copy ctor.
+   * This constructor was deleted.
+   */
+  EventLoop(const EventLoop&) = delete;
+
+  /**
+   * @brief Copy assignment operator.
+   * This opetator was deleted.
+   * @return EventLoop&
+   */
+  EventLoop& operator=(const EventLoop&) = delete;
+
+  /**
+   * @brief Return the loop of the calling thread, it is created on the first call.
+   * @return SharedPtr Loop of the calling thread.
+   */
+  static SharedPtr current();
+
+  /**
+   * @brief Add message to the inbox. Thread safe.
+   * @param func Message function.
+   */
+  void post(TaskFunction&& func);
+
+  /**
+   * @brief Execute messages posted before the call. Messages posted by them are left for the next call.
+   * If a message throws, the exception is rethrown and the rest messages stay in the inbox.
+   * @return std::size_t Number of executed messages.
+   */
+  std::size_t run_once();
+
+  /**
+   * @brief Execute messages until stop() is called. Waits for messages if the inbox is empty.
+   */
+  void run();
+
+  /**
+   * @brief Make run() return after the messages being executed. Thread safe.
+   * If run() is not running, the next call of run() returns at once.
+   */
+  void stop();
+
+  /**
+   * @brief Return number of messages in the inbox.
+   * @return std::size_t Number of messages.
+   */
+  std::size_t size() const;
+
+private:
+  /**
+   * @brief Messages in the inbox.
+   */
+  std::deque<TaskFunction> _inbox;
+  /**
+   * @brief Mutex guarding the inbox.
+   */
+  mutable std::mutex _mutex;
+  /**
+   * @brief Condition variable waking run().
+   */
+  std::condition_variable _cv;
+  /**
+   * @brief Stop flag of run().
+   */
+  bool _stopped;
+};
+}  // namespace core
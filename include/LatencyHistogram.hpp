@@ -0,0 +1,137 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace core {
+
+/**
+ * @brief This class represent log-linear latency histogram in the spirit of HdrHistogram.
+ * Every power of two range of nanoseconds is split into 8 buckets, so recorded values are kept
+ * with relative error below 12.5% for the whole range of std::uint64_t. Values below 8ns are exact.
+ * Recording is wait-free and is meant for a single writer thread, any thread may take a snapshot
+ * while the writer is recording.
+ */
+class LatencyHistogram {
+public:
+  /**
+   * @brief Number of buckets per power of two as a power of two.
+   */
+  static constexpr unsigned sub_bucket_bits = 3;
+  /**
+   * @brief Number of buckets per power of two.
+   */
+  static constexpr std::size_t sub_bucket_count = std::size_t{1} << sub_bucket_bits;
+  /**
+   * @brief Total number of buckets.
+   */
+  static constexpr std::size_t bucket_count = (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+  /**
+   * @brief Copy of the histogram counters. Snapshots of several histograms may be merged.
+   */
+  class Snapshot {
+  public:
+    /**
+     * @brief Construct a new empty Snapshot object.
+     */
+    Snapshot();
+
+    /**
+     * @brief Add counters of the other snapshot.
+     * @param other Merged snapshot.
+     * @return Snapshot& This snapshot.
+     */
+    Snapshot& merge(const Snapshot& other);
+
+    /**
+     * @brief Return number of recorded values.
+     * @return std::uint64_t Value count.
+     */
+    std::uint64_t count() const;
+
+    /**
+     * @brief Return the largest recorded value.
+     * @return std::chrono::nanoseconds Max value, 0 if nothing was recorded.
+     */
+    std::chrono::nanoseconds max() const;
+
+    /**
+     * @brief Return the mean of recorded values.
+     * @return std::chrono::nanoseconds Mean value, 0 if nothing was recorded.
+     */
+    std::chrono::nanoseconds mean() const;
+
+    /**
+     * @brief Return the value below or equal to which the given percentage of recorded values falls.
+     * The result is the highest value of the bucket, so it is not less than the exact percentile.
+     * @param percentile Percentage in range [0, 100].
+     * @return std::chrono::nanoseconds Percentile value, 0 if nothing was recorded.
+     */
+    std::chrono::nanoseconds percentile(double percentile) const;
+
+    /**
+     * @brief Return number of values recorded in the bucket.
+     * @param bucket Bucket index.
+     * @return std::uint64_t Value count.
+     */
+    std::uint64_t bucket(std::size_t bucket) const;
+
+  private:
+    friend class LatencyHistogram;
+
+    std::array<std::uint64_t, bucket_count> _counts;
+    std::uint64_t _count;
+    std::uint64_t _sum;
+    std::uint64_t _max;
+  };
+
+  /**
+   * @brief Construct a new empty LatencyHistogram object.
+   */
+  LatencyHistogram();
+
+  /**
+   * @brief Record the value. Negative values are recorded as 0. Must be called by a single thread.
+   * @param value Recorded latency.
+   */
+  void record(std::chrono::nanoseconds value);
+
+  /**
+   * @brief Copy the counters. Thread safe, counters updated during the copy may be partially included.
+   * @return Snapshot Copy of the counters.
+   */
+  Snapshot snapshot() const;
+
+  /**
+   * @brief Return bucket index of the value.
+   * @param value Value in nanoseconds.
+   * @return std::size_t Bucket index.
+   */
+  static std::size_t bucket_of(std::uint64_t value);
+
+  /**
+   * @brief Return the highest value of the bucket.
+   * @param bucket Bucket index.
+   * @return std::uint64_t Value in nanoseconds.
+   */
+  static std::uint64_t highest_of(std::size_t bucket);
+
+private:
+  /**
+   * @brief Increment the counter. Counters have the only writer, so read-modify-write is not needed.
+   */
+  static void add(std::atomic<std::uint64_t>& counter, std::uint64_t value)
+  {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+
+  std::array<std::atomic<std::uint64_t>, bucket_count> _counts;
+  std::atomic<std::uint64_t> _count;
+  std::atomic<std::uint64_t> _sum;
+  std::atomic<std::uint64_t> _max;
+};
+}  // namespace core
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <latch>
+#include <mutex>
+#include <type_traits>
+
+namespace core {
+
+/**
+ * @brief This class represent index range shared between threads of parallel loop.
+ * Participants claim chunks of decreasing size (guided scheduling): a chunk is
+ * remaining / (2 * participants) indices, but not less than the grain size.
+ * Chunk bounds depend only on the chunk start, so the number of chunks is known in advance
+ * and completion of all chunks is tracked by a single latch.
+ * @tparam Index Integral index type.
+ */
+template <typename Index>
+class ParallelRange {
+  static_assert(std::is_integral_v<Index>, "ParallelRange requires integral index type");
+
+public:
+  /**
+   * @brief Construct a new ParallelRange object.
+   * @param[in] begin First index.
+   * @param[in] end Index after the last one. Must not be less than begin.
+   * @param[in] grain Min chunk size.
+   * @param[in] participants Number of threads processing the range.
+   */
+  ParallelRange(Index begin, Index end, Index grain, std::uint32_t participants)
+    : _next(begin)
+    , _end(end)
+    , _grain(std::max<Index>(grain, 1))
+    , _participants(std::max<std::uint32_t>(participants, 1))
+    , _done(count_chunks(begin))
+  {
+  }
+
+  /**
+   * @brief Process chunks until the range is exhausted.
+   * @tparam Body Callable object taking chunk bounds (first, last).
+   * @tparam Finish Callable object without arguments, it is called once after the last processed chunk.
+   * It is not called if the participant has not processed any chunk.
+   * @param body Chunk handler.
+   * @param finish Finish handler.
+   */
+  template <typename Body, typename Finish>
+  void run(Body&& body, Finish&& finish)
+  {
+    std::ptrdiff_t processed = 0;
+    Index first;
+    Index last;
+    try {
+      while (next_chunk(first, last)) {
+        ++processed;
+        body(first, last);
+      }
+      if (processed != 0) {
+        finish();
+      }
+    } catch (...) {
+      cancel(std::current_exception());
+    }
+    if (processed != 0) {
+      _done.count_down(processed);
+    }
+  }
+
+  /**
+   * @brief Wait until all chunks are processed.
+   * @throw Rethrows the first exception thrown by chunk or finish handlers.
+   */
+  void wait()
+  {
+    _done.wait();
+    if (_error) {
+      std::rethrow_exception(_error);
+    }
+  }
+
+private:
+  /**
+   * @brief Claim next chunk.
+   * @param[out] first First index of the chunk.
+   * @param[out] last Index after the last one of the chunk.
+   * @return true If chunk was claimed.
+   * @return false If the range is exhausted.
+   */
+  bool next_chunk(Index& first, Index& last)
+  {
+    first = _next.load(std::memory_order_relaxed);
+    do {
+      if (first >= _end) {
+        return false;
+      }
+      last = first + chunk_size(first);
+    } while (!_next.compare_exchange_weak(first, last, std::memory_order_relaxed));
+    return true;
+  }
+
+  /**
+   * @brief Return size of the chunk starting at the index.
+   * @param first First index of the chunk, less than the end of the range.
+   */
+  Index chunk_size(Index first) const
+  {
+    const Index remaining = _end - first;
+    return std::min(remaining, std::max<Index>(_grain, remaining / (2 * _participants)));
+  }
+
+  /**
+   * @brief Return number of chunks from the index to the end of the range. The chunk size decreases geometrically
+   * down to the grain, so the number is small and fits the latch for any range.
+   * @param first First index of a chunk.
+   */
+  std::ptrdiff_t count_chunks(Index first) const
+  {
+    std::ptrdiff_t count = 0;
+    for (; first < _end; first += chunk_size(first)) {
+      ++count;
+    }
+    return count;
+  }
+
+  /**
+   * @brief Save the first exception and complete all unclaimed chunks, so wait() returns as soon as
+   * already claimed chunks are finished.
+   * @param error Thrown exception.
+   */
+  void cancel(std::exception_ptr error)
+  {
+    {
+      const std::lock_guard lock(_error_mutex);
+      if (!_error) {
+        _error = error;
+      }
+    }
+    const Index first = _next.exchange(_end, std::memory_order_relaxed);
+    if (first < _end) {
+      _done.count_down(count_chunks(first));
+    }
+  }
+
+  /**
+   * @brief Next unclaimed index.
+   */
+  std::atomic<Index> _next;
+  /**
+   * @brief Index after the last one.
+   */
+  const Index _end;
+  /**
+   * @brief Min chunk size.
+   */
+  const Index _grain;
+  /**
+   * @brief Number of threads processing the range.
+   */
+  const std::uint32_t _participants;
+  /**
+   * @brief Number of unprocessed chunks.
+   */
+  std::latch _done;
+  /**
+   * @brief Mutex for saving exception.
+   */
+  std::mutex _error_mutex;
+  /**
+   * @brief The first exception thrown by participants.
+   */
+  std::exception_ptr _error;
+};
+}  // namespace core
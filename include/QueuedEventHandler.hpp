@@ -0,0 +1,175 @@
+#pragma once
+
+#include "EventHandlerImpl.hpp"
+#include "EventLoop.hpp"
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace core {
+
+/**
+ * @brief Event handler of the queued subscription. Notification posts a message with a copy of
+ * the argument to the event loop of the consumer thread, the wrapped handler is called by the loop.
+ * Messages posted before the subscription is removed are skipped if they are executed after the removal,
+ * so removing the subscription in the consumer thread, including removal from a handler, guarantees
+ * the handler is not called anymore.
+ * Messages are dropped if the loop is destroyed.
+ * @tparam T Argument type.
+ */
+template <typename T>
+class QueuedEventHandler : public EventHandlerImpl<T> {
+public:
+  /**
+   * @brief Construct a new QueuedEventHandler object.
+   * @param pHandler[in] Wrapped handler.
+   * @param pLoop[in] Event loop of the consumer thread.
+   */
+  QueuedEventHandler(EventHandlerImplPtr<T> pHandler, const EventLoop::SharedPtr& pLoop)
+    : EventHandlerImpl<T>(MakeWrappedEventHandlerKey<QueuedEventHandler<T>>(*pHandler)),
+      pTarget_(std::make_shared<Target>(std::move(pHandler))),
+      pLoop_(pLoop)
+  {
+  }
+
+  /**
+   * @brief Stop delivery when the subscription is removed. Messages left in the loop are skipped.
+   */
+  virtual void OnUnsubscribed() override final { pTarget_->active.store(false, std::memory_order_release); }
+
+  /**
+   * @brief Post the notification to the event loop.
+   * @param[in] psender Pointer to the sender.
+   * @param[in] arg Passed argument.
+   */
+  virtual void OnEvent(const void* psender, const T& arg) override final
+  {
+    if (!pTarget_->active.load(std::memory_order_acquire)) {
+      return;
+    }
+    if (const auto pLoop = pLoop_.lock()) {
+      pLoop->post([pTarget = pTarget_, psender, arg] {
+        if (pTarget->active.load(std::memory_order_acquire)) {
+          pTarget->delegate(psender, arg);
+        }
+      });
+    }
+  }
+
+  /**
+   * @brief Сhecks the current and passed event handler.
+   * Compares keys of the handlers computed at construction.
+   * @param[in] pHandler Pointer to the event handler.
+   * @return true If both handlers are queued and wrap handlers bound to the same function.
+   * @return false Otherwise.
+   */
+  virtual bool IsBindedToSameFunctionAs(const EventHandlerImplBase<T>* pHandler) const override final
+  {
+    return pHandler && this->Key() == pHandler->Key();
+  }
+
+private:
+  /**
+   * @brief Wrapped handler shared with posted messages.
+   */
+  struct Target {
+    explicit Target(EventHandlerImplPtr<T> pHandler)
+      : pHandler(std::move(pHandler)), delegate(this->pHandler->ToDelegate()), active(true)
+    {
+    }
+
+    EventHandlerImplPtr<T> pHandler;
+    EventDelegate<T> delegate;
+    std::atomic<bool> active;
+  };
+
+  /**
+   * @brief Wrapped handler.
+   */
+  std::shared_ptr<Target> pTarget_;
+  /**
+   * @brief Event loop of the consumer thread.
+   */
+  std::weak_ptr<EventLoop> pLoop_;
+};
+
+/**
+ * @brief This is specialization QueuedEventHandler for void type.
+ * Notification posts a message to the event loop of the consumer thread.
+ */
+template <>
+class QueuedEventHandler<void> : public EventHandlerImpl<void> {
+public:
+  /**
+   * @brief Construct a new QueuedEventHandler object.
+   * @param pHandler[in] Wrapped handler.
+   * @param pLoop[in] Event loop of the consumer thread.
+   */
+  QueuedEventHandler(EventHandlerImplPtr<void> pHandler, const EventLoop::SharedPtr& pLoop)
+    : EventHandlerImpl<void>(MakeWrappedEventHandlerKey<QueuedEventHandler<void>>(*pHandler)),
+      pTarget_(std::make_shared<Target>(std::move(pHandler))),
+      pLoop_(pLoop)
+  {
+  }
+
+  /**
+   * @brief Stop delivery when the subscription is removed. Messages left in the loop are skipped.
+   */
+  virtual void OnUnsubscribed() override final { pTarget_->active.store(false, std::memory_order_release); }
+
+  /**
+   * @brief Post the notification to the event loop.
+   * @param[in] psender Pointer to the sender.
+   */
+  virtual void OnEvent(const void* psender) override final
+  {
+    if (!pTarget_->active.load(std::memory_order_acquire)) {
+      return;
+    }
+    if (const auto pLoop = pLoop_.lock()) {
+      pLoop->post([pTarget = pTarget_, psender] {
+        if (pTarget->active.load(std::memory_order_acquire)) {
+          pTarget->delegate(psender);
+        }
+      });
+    }
+  }
+
+  /**
+   * @brief Сhecks the current and passed event handler.
+   * Compares keys of the handlers computed at construction.
+   * @param[in] pHandler Pointer to the event handler.
+   * @return true If both handlers are queued and wrap handlers bound to the same function.
+   * @return false Otherwise.
+   */
+  virtual bool IsBindedToSameFunctionAs(const EventHandlerImplBase<void>* pHandler) const override final
+  {
+    return pHandler && Key() == pHandler->Key();
+  }
+
+private:
+  /**
+   * @brief Wrapped handler shared with posted messages.
+   */
+  struct Target {
+    explicit Target(EventHandlerImplPtr<void> pHandler)
+      : pHandler(std::move(pHandler)), delegate(this->pHandler->ToDelegate()), active(true)
+    {
+    }
+
+    EventHandlerImplPtr<void> pHandler;
+    EventDelegate<void> delegate;
+    std::atomic<bool> active;
+  };
+
+  /**
+   * @brief Wrapped handler.
+   */
+  std::shared_ptr<Target> pTarget_;
+  /**
+   * @brief Event loop of the consumer thread.
+   */
+  std::weak_ptr<EventLoop> pLoop_;
+};
+}  // namespace core
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+namespace core {
+
+/**
+ * @brief Interface of the subscription owner (event) used by Subscription to disconnect.
+ */
+class SubscriptionSource {
+public:
+  /**
+   * @brief Default dtor. Destruct SubscriptionSource instance.
+   */
+  virtual ~SubscriptionSource() = default;
+
+  /**
+   * @brief Remove the subscription. Does nothing if the subscription was already removed.
+   * @param slot[in] Slot index of the subscription.
+   * @param generation[in] Generation of the slot when the subscription was created.
+   */
+  virtual void Disconnect(std::uint32_t slot, std::uint32_t generation) = 0;
+};
+
+/**
+ * @brief This class implement move-only RAII token of the event subscription.
+ * The subscription is removed when the token is destroyed or disconnect() is called.
+ * The token refers to the subscription by slot index and generation, so removal does not search
+ * the handler. The token may outlive the event, in this case it does nothing.
+ */
+class Subscription {
+public:
+  /**
+   * @brief Construct a new empty Subscription object.
+   */
+  Subscription() noexcept;
+
+  /**
+   * @brief Construct a new Subscription object.
+   * @param source[in] Event owning the subscription.
+   * @param slot[in] Slot index of the subscription.
+   * @param generation[in] Generation of the slot.
+   */
+  Subscription(std::weak_ptr<SubscriptionSource> source, std::uint32_t slot, std::uint32_t generation) noexcept;
+
+  /**
+   * @brief Move ctor.
+   * @param other Moved object, it becomes empty.
+   */
+  Subscription(Subscription&& other) noexcept;
+
+  /**
+   * @brief Move assignment operator. Current subscription is removed, errors of the removal are ignored.
+   * @param other Moved object, it becomes empty.
+   * @return Subscription&
+   */
+  Subscription& operator=(Subscription&& other) noexcept;
+
+  /**
+   * @brief Copy ctor.
+   * This constructor was deleted.
+   */
+  Subscription(const Subscription&) = delete;
+
+  /**
+   * @brief Copy assignment operator.
+   * This opetator was deleted.
+   * @return Subscription&
+   */
+  Subscription& operator=(const Subscription&) = delete;
+
+  /**
+   * @brief Destroy the Subscription object and remove the subscription, errors of the removal are ignored.
+   */
+  ~Subscription();
+
+  /**
+   * @brief Remove the subscription, the token becomes empty.
+   * Rethrows exception thrown by OnUnsubscribed() of the removed handler, the token is empty anyway.
+   */
+  void disconnect();
+
+  /**
+   * @brief Make the token empty without removing the subscription.
+   */
+  void release() noexcept;
+
+  /**
+   * @brief Checks if the token refers to a subscription of an alive event.
+   * @return true If the token is not empty and the event is alive.
+   * @return false Otherwise.
+   */
+  bool connected() const noexcept;
+
+private:
+  /**
+   * @brief Remove the subscription ignoring errors, used by the destructor and move assignment.
+   */
+  void reset() noexcept;
+
+  /**
+   * @brief Event owning the subscription.
+   */
+  std::weak_ptr<SubscriptionSource> source_;
+  /**
+   * @brief Slot index of the subscription.
+   */
+  std::uint32_t slot_;
+  /**
+   * @brief Generation of the slot.
+   */
+  std::uint32_t generation_;
+};
+}  // namespace core
@@ -1,5 +1,10 @@
 #pragma once
 
+#include "TaskAwaitable.hpp"
+#include "TaskFunction.hpp"
+
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -35,25 +40,72 @@ using member_function_return_type_t = typename member_function_return_type<FuncT
  */
 enum class TaskPriority : std::uint8_t { Lowest, Low, Medium, High, Highest };
 
+/**
+ * @brief Number of task priority levels.
+ */
+inline constexpr std::size_t task_priority_count = static_cast<std::size_t>(TaskPriority::Highest) + 1;
+
+/**
+ * @brief Enum class for selecting how the thread pool executes a task picked up by the thread which created it.
+ * Inline - the task is executed in place.
+ * Reschedule - the task is pushed back to the pool queue once, so another thread may execute it.
+ * If the task is picked up by the same thread again or can not be pushed back, it is executed in place.
+ */
+enum class ExecutionPolicy : std::uint8_t { Inline, Reschedule };
+
 /**
  * @brief This class is used as a wrapper over the passed functional objects.
  * Functional objects can be ordinary functions or class methods.
+ * Task is move-only, small functional objects with their arguments are stored inside the task
+ * without heap allocation.
  */
 class Task {
 public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Deadline of the task without deadline.
+   */
+  static constexpr Clock::time_point no_deadline = Clock::time_point::max();
+
   /**
    * @brief For access task priority field.
    */
   friend struct TaskComparator;
 
   /**
-   * @brief Construct a new Task object. May pass task priority.
+   * @brief Construct a new Task object. May pass task priority and execution policy.
    * @param priority Priority task.
+   * @param policy Execution policy for the thread which created the task.
+   */
+  Task(TaskPriority priority = TaskPriority::Medium, ExecutionPolicy policy = ExecutionPolicy::Inline);
+
+  /**
+   * @brief Move ctor.
    */
-  Task(TaskPriority priority = TaskPriority::Medium);
+  Task(Task&&) noexcept = default;
 
   /**
-   * @brief Wraps a function with a variable number of arguments in std::function<void> object.
+   * @brief Move assignment operator.
+   * @return Task&
+   */
+  Task& operator=(Task&&) noexcept = default;
+
+  /**
+   * @brief Copy ctor.
+   * This constructor was deleted.
+   */
+  Task(const Task&) = delete;
+
+  /**
+   * @brief Copy assignment operator.
+   * This opetator was deleted.
+   * @return Task&
+   */
+  Task& operator=(const Task&) = delete;
+
+  /**
+   * @brief Wraps a function with a variable number of arguments in TaskFunction object.
    * Return std::future<bool> if returning type has void. If function execution was failed result are
    * setted as std::current_exception().
    * @tparam F Function object.
@@ -65,17 +117,18 @@ public:
             typename = std::enable_if_t<std::is_void_v<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>>>
   [[nodiscard]] std::future<bool> assign(F&& func, Args&&... args)
   {
-    std::shared_ptr<std::promise<bool>> tsk_promise(new std::promise<bool>);
-    auto future = tsk_promise->get_future();
-    _func = [func = std::forward<F>(func), args = std::make_tuple(std::forward<Args>(args)...), tsk_promise] {
+    std::promise<bool> tsk_promise;
+    auto future = tsk_promise.get_future();
+    _func = [func = std::forward<F>(func), args = std::make_tuple(std::forward<Args>(args)...),
+             tsk_promise = std::move(tsk_promise)]() mutable {
       try {
         std::apply(func, std::move(args));
-        tsk_promise->set_value(true);
+        tsk_promise.set_value(true);
       } catch (...) {
         try {
-          tsk_promise->set_exception(std::current_exception());
+          tsk_promise.set_exception(std::current_exception());
         } catch (...) {
-          tsk_promise->set_value(false);
+          tsk_promise.set_value(false);
         }
       }
     };
@@ -83,7 +136,7 @@ public:
   }
 
   /**
-   * @brief Wraps a function with a variable number of arguments in std::function<void> object.
+   * @brief Wraps a function with a variable number of arguments in TaskFunction object.
    * Return std::future<R> if returning type has not void. If function execution was failed result are
    * setted as std::current_exception().
    * @tparam F Function object.
@@ -96,14 +149,15 @@ public:
             typename = std::enable_if_t<!std::is_void_v<R>>>
   [[nodiscard]] std::future<R> assign(F&& func, Args&&... args)
   {
-    std::shared_ptr<std::promise<R>> tsk_promise(new std::promise<R>);
-    std::future<R> future = tsk_promise->get_future();
-    _func = [func = std::forward<F>(func), args = std::make_tuple(std::forward<Args>(args)...), tsk_promise] {
+    std::promise<R> tsk_promise;
+    std::future<R> future = tsk_promise.get_future();
+    _func = [func = std::forward<F>(func), args = std::make_tuple(std::forward<Args>(args)...),
+             tsk_promise = std::move(tsk_promise)]() mutable {
       try {
-        tsk_promise->set_value(std::apply(func, std::move(args)));
+        tsk_promise.set_value(std::apply(func, std::move(args)));
       } catch (...) {
         try {
-          tsk_promise->set_exception(std::current_exception());
+          tsk_promise.set_exception(std::current_exception());
         } catch (...) {
         }
       }
@@ -112,7 +166,7 @@ public:
   }
 
   /**
-   * @brief Wraps a member function with a variable number of arguments in std::function<void> object.
+   * @brief Wraps a member function with a variable number of arguments in TaskFunction object.
    * Return std::future<bool> if returning type has void. If member function execution was failed result are
    * setted as std::current_exception().
    * @tparam T Class contains member function type as FuncT.
@@ -125,17 +179,18 @@ public:
             typename = std::enable_if_t<std::is_void_v<std::decay_t<member_function_return_type_t<FuncT>>>>>
   [[nodiscard]] std::future<bool> assign(T pobj, FuncT pfunc, Args&&... args)
   {
-    std::shared_ptr<std::promise<bool>> tsk_promise(new std::promise<bool>);
-    std::future<bool> future = tsk_promise->get_future();
-    _func = [pobj, pfunc, args = std::make_tuple(std::forward<Args>(args)...), tsk_promise] {
+    std::promise<bool> tsk_promise;
+    std::future<bool> future = tsk_promise.get_future();
+    _func = [pobj, pfunc, args = std::make_tuple(std::forward<Args>(args)...),
+             tsk_promise = std::move(tsk_promise)]() mutable {
       try {
         std::apply(pfunc, std::tuple_cat(std::make_tuple(pobj), std::move(args)));
-        tsk_promise->set_value(true);
+        tsk_promise.set_value(true);
       } catch (...) {
         try {
-          tsk_promise->set_exception(std::current_exception());
+          tsk_promise.set_exception(std::current_exception());
         } catch (...) {
-          tsk_promise->set_value(false);
+          tsk_promise.set_value(false);
         }
       }
     };
@@ -143,7 +198,7 @@ public:
   }
 
   /**
-   * @brief Wraps a member function with a variable number of arguments in std::function<void> object.
+   * @brief Wraps a member function with a variable number of arguments in TaskFunction object.
    * Return std::future<R> if returning type has void. If member function execution was failed result are
    * setted as std::current_exception().
    * @tparam T Class contains member function type as FuncT.
@@ -157,14 +212,15 @@ public:
             typename = std::enable_if_t<!std::is_void_v<std::decay_t<R>>>>
   [[nodiscard]] std::future<R> assign(T pobj, FuncT pfunc, Args&&... args)
   {
-    std::shared_ptr<std::promise<R>> tsk_promise(new std::promise<R>);
-    std::future<R> future = tsk_promise->get_future();
-    _func = [pobj, pfunc, args = std::make_tuple(std::forward<Args>(args)...), tsk_promise] {
+    std::promise<R> tsk_promise;
+    std::future<R> future = tsk_promise.get_future();
+    _func = [pobj, pfunc, args = std::make_tuple(std::forward<Args>(args)...),
+             tsk_promise = std::move(tsk_promise)]() mutable {
       try {
-        tsk_promise->set_value(std::apply(pfunc, std::tuple_cat(std::make_tuple(pobj), std::move(args))));
+        tsk_promise.set_value(std::apply(pfunc, std::tuple_cat(std::make_tuple(pobj), std::move(args))));
       } catch (...) {
         try {
-          tsk_promise->set_exception(std::current_exception());
+          tsk_promise.set_exception(std::current_exception());
         } catch (...) {
         }
       }
@@ -172,33 +228,202 @@ public:
     return future;
   }
 
+  /**
+   * @brief Wraps a function with a variable number of arguments in TaskFunction object.
+   * Return TaskAwaitable<R> which may be awaited by a coroutine via co_await instead of blocking on std::future.
+   * If function execution was failed the exception is rethrown by co_await.
+   * @tparam F Function object or pointer to the member function.
+   * @tparam Args Passed arguments, for member function the first one is pointer to the object.
+   * @tparam R Returning type.
+   * @return TaskAwaitable<R> Awaitable result.
+   */
+  template <typename F, typename... Args, typename R = std::invoke_result_t<std::decay_t<F>&, std::decay_t<Args>...>>
+  [[nodiscard]] TaskAwaitable<R> assign_awaitable(F&& func, Args&&... args)
+  {
+    auto [result, tsk_promise] = TaskAwaitable<R>::create();
+    _func = [func = std::forward<F>(func), args = std::make_tuple(std::forward<Args>(args)...),
+             tsk_promise = std::move(tsk_promise)]() mutable {
+      try {
+        if constexpr (std::is_void_v<R>) {
+          std::apply(func, std::move(args));
+          tsk_promise.set_value();
+        } else {
+          tsk_promise.set_value(std::apply(func, std::move(args)));
+        }
+      } catch (...) {
+        tsk_promise.set_exception(std::current_exception());
+      }
+    };
+    return std::move(result);
+  }
+
+  /**
+   * @brief Wraps a function with a variable number of arguments in TaskFunction object without
+   * creating std::promise. Returning value is ignored. Exceptions thrown by the function are not caught
+   * and leave operator()(), thread pool passes them to its error handler.
+   * @tparam F Function object.
+   * @tparam Args Passed arguments.
+   */
+  template <typename F, typename... Args,
+            typename = std::enable_if_t<std::is_invocable_v<std::decay_t<F>&, std::decay_t<Args>...>>>
+  void assign_detached(F&& func, Args&&... args)
+  {
+    _func = [func = std::forward<F>(func), args = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+      std::apply(func, std::move(args));
+    };
+  }
+
+  /**
+   * @brief Wraps a member function with a variable number of arguments in TaskFunction object without
+   * creating std::promise. Returning value is ignored. Exceptions thrown by the member function are not caught
+   * and leave operator()(), thread pool passes them to its error handler.
+   * @tparam T Class contains member function type as FuncT.
+   * @tparam FuncT Member function type.
+   * @tparam Args Passed arguments.
+   */
+  template <typename T, typename FuncT, typename... Args,
+            typename = std::enable_if_t<std::is_member_function_pointer_v<FuncT>>>
+  void assign_detached(T pobj, FuncT pfunc, Args&&... args)
+  {
+    _func = [pobj, pfunc, args = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+      std::apply(pfunc, std::tuple_cat(std::make_tuple(pobj), std::move(args)));
+    };
+  }
+
   /**
    * @brief Checks for an empty function object.
-   * @return true If std::function<void> is empty.
+   * @return true If TaskFunction is empty.
    * @return false Otherwise.
    */
   bool empty() const;
 
   /**
-   * @brief Execution operator for current functional object.
-   * If the task is launched in the thread in which it was created, then a deadlock will occur.
-   * In this case, it is moved to an asynchronous call, otherwise it is executed as is.
+   * @brief Return task priority.
+   * @return TaskPriority Task priority.
    */
-  void operator()() const
-  {
-    if (_curr_thread_id == std::this_thread::get_id()) {
-      auto f = std::async(_func);
-      f.wait();
-    } else {
-      _func();
-    }
-  }
+  TaskPriority priority() const;
+
+  /**
+   * @brief Set the time point the task has to be started before. Expired tasks are dropped or counted
+   * by the thread pool, deadline queue extracts tasks in the order of their deadlines.
+   * @param deadline Deadline, no_deadline resets it.
+   */
+  void set_deadline(Clock::time_point deadline);
+
+  /**
+   * @brief Return task deadline.
+   * @return Clock::time_point Deadline, no_deadline if it was not set.
+   */
+  Clock::time_point deadline() const;
+
+  /**
+   * @brief Check the task has a deadline which has passed. Clock is not read for tasks without deadline.
+   * @return true If the deadline was set and has passed.
+   * @return false Otherwise.
+   */
+  bool is_expired() const;
+
+#ifdef CORE_ENABLE_METRICS
+  /**
+   * @brief Remember the time the task was enqueued, used by thread pool metrics.
+   * @param now Enqueuing time.
+   */
+  void mark_enqueued(Clock::time_point now) { _enqueue_time = now; }
+
+  /**
+   * @brief Return the time the task was enqueued.
+   * @return Clock::time_point Enqueuing time.
+   */
+  Clock::time_point enqueue_time() const { return _enqueue_time; }
+#endif
+
+#ifdef CORE_ENABLE_TRACING
+  /**
+   * @brief Set the flow id connecting the push and the execution of the task in the trace.
+   * @param id Flow id, 0 if the push was not traced.
+   */
+  void set_trace_id(std::uint64_t id) { _trace_id = id; }
+
+  /**
+   * @brief Return the flow id of the task.
+   * @return std::uint64_t Flow id, 0 if the push was not traced.
+   */
+  std::uint64_t trace_id() const { return _trace_id; }
+#endif
+
+  /**
+   * @brief Allow or forbid the thread pool to drop the task by DropOldest overflow policy or Drop expired task policy.
+   * Tasks other code waits for, e.g. graph nodes and coroutine resumption, must not be dropped.
+   * @param droppable False if the task must be executed, an evicted task is executed by the pushing thread then.
+   */
+  void set_droppable(bool droppable);
+
+  /**
+   * @brief Checks the task may be dropped by the thread pool.
+   * @return true If the task may be dropped, by default.
+   * @return false If the task must be executed.
+   */
+  bool is_droppable() const;
+
+  /**
+   * @brief Return task execution policy.
+   * @return ExecutionPolicy Execution policy.
+   */
+  ExecutionPolicy execution_policy() const;
+
+  /**
+   * @brief Checks if the current thread is the thread which created the task.
+   * @return true If the task is executed reentrantly.
+   * @return false Otherwise.
+   */
+  bool is_reentrant() const;
+
+  /**
+   * @brief Mark the task as rescheduled.
+   * @return true If the task has Reschedule policy and was not rescheduled before.
+   * @return false Otherwise, the task must be executed in place.
+   */
+  bool mark_rescheduled();
+
+  /**
+   * @brief Execution operator for current functional object. The function is always executed
+   * in the calling thread, reentrant execution is handled by the thread pool according to the execution policy.
+   */
+  void operator()() { _func(); }
 
 private:
   /**
    * @brief Task priority.
    */
   TaskPriority _priority;
+  /**
+   * @brief Execution policy for the thread which created the task.
+   */
+  ExecutionPolicy _policy;
+  /**
+   * @brief True if the task was pushed back to the pool queue by the thread which created it.
+   */
+  bool _rescheduled;
+  /**
+   * @brief False if the task must not be dropped by the thread pool.
+   */
+  bool _droppable;
+  /**
+   * @brief Time point the task has to be started before.
+   */
+  Clock::time_point _deadline;
+#ifdef CORE_ENABLE_METRICS
+  /**
+   * @brief Time the task was enqueued.
+   */
+  Clock::time_point _enqueue_time;
+#endif
+#ifdef CORE_ENABLE_TRACING
+  /**
+   * @brief Flow id of the task in the trace.
+   */
+  std::uint64_t _trace_id = 0;
+#endif
   /**
    * @brief Thread id in which the task was created.
    */
@@ -206,10 +431,13 @@ private:
   /**
    * @brief Functional object for execution.
    */
-  std::function<void()> _func;
+  TaskFunction _func;
 };
 
+/**
+ * @brief Comparator for std::priority_queue, tasks with higher priority are extracted first.
+ */
 struct TaskComparator {
-  bool operator()(const Task& t1, const Task& t2) const { return t1._priority > t2._priority; }
+  bool operator()(const Task& t1, const Task& t2) const { return t1._priority < t2._priority; }
 };
 }  // namespace core
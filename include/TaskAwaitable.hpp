@@ -0,0 +1,161 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace core {
+
+/**
+ * @brief This class represent result of a task which may be awaited by a coroutine via co_await.
+ * Unlike std::future it does not block a thread: the awaiting coroutine is suspended and resumed
+ * by the thread which finished the task. Result may be awaited only once.
+ * @tparam R Result type.
+ */
+template <typename R>
+class TaskAwaitable {
+  using ValueT = std::conditional_t<std::is_void_v<R>, std::monostate, R>;
+
+  /**
+   * @brief Shared state between the task and the awaiting coroutine.
+   */
+  class State {
+  public:
+    State() : _status(Status::Empty) {}
+
+    /**
+     * @brief Save the result and resume the awaiting coroutine if there is one.
+     */
+    template <typename... V>
+    void set_value(V&&... value)
+    {
+      _value.emplace(std::forward<V>(value)...);
+      complete();
+    }
+
+    /**
+     * @brief Save the exception and resume the awaiting coroutine if there is one.
+     */
+    void set_exception(std::exception_ptr error)
+    {
+      _error = error;
+      complete();
+    }
+
+    /**
+     * @brief Checks if the result is set.
+     */
+    bool ready() const { return _status.load(std::memory_order_acquire) == Status::Ready; }
+
+    /**
+     * @brief Register the awaiting coroutine.
+     * @return true If the coroutine must be suspended.
+     * @return false If the result is already set, the coroutine continues at once.
+     */
+    bool suspend(std::coroutine_handle<> handle)
+    {
+      _handle = handle;
+      auto expected = Status::Empty;
+      return _status.compare_exchange_strong(expected, Status::Waiting, std::memory_order_acq_rel);
+    }
+
+    /**
+     * @brief Return the result or rethrow the exception.
+     */
+    R take()
+    {
+      if (_error) {
+        std::rethrow_exception(_error);
+      }
+      if constexpr (!std::is_void_v<R>) {
+        return std::move(*_value);
+      }
+    }
+
+  private:
+    enum class Status : std::uint8_t { Empty, Waiting, Ready };
+
+    void complete()
+    {
+      if (_status.exchange(Status::Ready, std::memory_order_acq_rel) == Status::Waiting) {
+        _handle.resume();
+      }
+    }
+
+    std::atomic<Status> _status;
+    std::coroutine_handle<> _handle;
+    std::optional<ValueT> _value;
+    std::exception_ptr _error;
+  };
+
+public:
+  /**
+   * @brief Producer side of the result, it is owned by the task. If it is destroyed without
+   * setting the result, the awaiting coroutine gets std::future_error with broken_promise code.
+   */
+  class Promise {
+  public:
+    explicit Promise(std::shared_ptr<State> state) : _state(std::move(state)) {}
+    Promise(Promise&&) noexcept = default;
+    Promise& operator=(Promise&&) = delete;
+    Promise(const Promise&) = delete;
+    Promise& operator=(const Promise&) = delete;
+
+    ~Promise()
+    {
+      if (_state && !_state->ready()) {
+        _state->set_exception(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+      }
+    }
+
+    template <typename... V>
+    void set_value(V&&... value)
+    {
+      _state->set_value(std::forward<V>(value)...);
+    }
+
+    void set_exception(std::exception_ptr error) { _state->set_exception(error); }
+
+  private:
+    std::shared_ptr<State> _state;
+  };
+
+  /**
+   * @brief Create connected pair of awaitable result and its promise.
+   * @return std::pair<TaskAwaitable, Promise>
+   */
+  static std::pair<TaskAwaitable, Promise> create()
+  {
+    auto state = std::make_shared<State>();
+    return {TaskAwaitable(state), Promise(state)};
+  }
+
+  /**
+   * @brief Checks if the result is set.
+   * @return true If the task was finished.
+   * @return false Otherwise.
+   */
+  bool ready() const { return _state->ready(); }
+
+  bool await_ready() const noexcept { return _state->ready(); }
+
+  bool await_suspend(std::coroutine_handle<> handle) { return _state->suspend(handle); }
+
+  R await_resume() { return _state->take(); }
+
+private:
+  explicit TaskAwaitable(std::shared_ptr<State> state) : _state(std::move(state)) {}
+
+  /**
+   * @brief Shared state.
+   */
+  std::shared_ptr<State> _state;
+};
+}  // namespace core
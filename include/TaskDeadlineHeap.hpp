@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Task.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core {
+
+/**
+ * @brief This class represent earliest-deadline-first task heap. Tasks are extracted in the order of
+ * their deadlines, tasks with equal deadlines (including tasks without deadline) in the order of priority,
+ * tasks with equal priority in FIFO order. Insertion and extraction take O(log n) time, extraction of the
+ * lowest priority task takes O(n) time. The class is not thread safe, the owner has to guard it.
+ */
+class TaskDeadlineHeap {
+public:
+  /**
+   * @brief Construct a new empty TaskDeadlineHeap object.
+   */
+  TaskDeadlineHeap();
+
+  /**
+   * @brief Enqueue task.
+   * @param[in] task
+   */
+  void push_back(Task&& task);
+
+  /**
+   * @brief Extract the task with the earliest deadline.
+   * @param[out] task Extracted task.
+   * @return true If task was extracted.
+   * @return false If the heap is empty.
+   */
+  bool pop_front(Task& task);
+
+  /**
+   * @brief Extract the oldest task with the lowest priority.
+   * @param[out] task Extracted task.
+   * @return true If task was extracted.
+   * @return false If the heap is empty.
+   */
+  bool pop_front_lowest(Task& task);
+
+  /**
+   * @brief Extract the oldest task with the lowest priority if its priority is not higher than the given one.
+   * @param[out] task Extracted task.
+   * @param[in] max_priority Max priority of the extracted task.
+   * @return true If task was extracted.
+   * @return false If the heap is empty or the lowest priority is higher than max_priority.
+   */
+  bool pop_front_lowest(Task& task, TaskPriority max_priority);
+
+  /**
+   * @brief Check that tasks with different priorities are waiting.
+   * @return true If tasks with different priorities are waiting.
+   * @return false Otherwise.
+   */
+  bool has_lower_lanes() const;
+
+  /**
+   * @brief Check the heap is empty.
+   * @return true If the heap is empty.
+   * @return false Otherwise.
+   */
+  bool empty() const;
+
+  /**
+   * @brief Clear the heap.
+   */
+  void clear();
+
+private:
+  /**
+   * @brief Heap entry, sequence number keeps FIFO order of equal tasks.
+   */
+  struct Entry {
+    Task task;
+    std::uint64_t sequence;
+  };
+
+  /**
+   * @brief Heap comparator, the first entry has to be extracted after the second one.
+   */
+  static bool later(const Entry& e1, const Entry& e2);
+
+  /**
+   * @brief Remove the entry and restore the heap.
+   * @param index Entry index.
+   * @param[out] task Extracted task.
+   */
+  void take(std::size_t index, Task& task);
+
+  /**
+   * @brief Heap entries.
+   */
+  std::vector<Entry> _heap;
+  /**
+   * @brief Number of queued tasks per priority level.
+   */
+  std::array<std::size_t, task_priority_count> _counts;
+  /**
+   * @brief Sequence number of the next enqueued task.
+   */
+  std::uint64_t _sequence;
+};
+}  // namespace core
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace core {
+
+/**
+ * @brief This class represent move-only wrapper over a callable object without arguments and returning value.
+ * Callable objects up to buffer_size bytes with nothrow move constructor are stored inside the wrapper,
+ * so wrapping them does not allocate memory. Bigger callable objects are allocated in the heap.
+ */
+class TaskFunction {
+public:
+  /**
+   * @brief Size of the inline buffer for callable objects.
+   */
+  static constexpr std::size_t buffer_size = 64;
+
+  /**
+   * @brief Construct a new empty TaskFunction object.
+   */
+  TaskFunction() noexcept : _ops(nullptr) {}
+
+  /**
+   * @brief Construct a new empty TaskFunction object.
+   */
+  TaskFunction(std::nullptr_t) noexcept : _ops(nullptr) {}
+
+  /**
+   * @brief Construct a new TaskFunction object wrapping the passed callable object.
+   * @tparam F Callable object type.
+   * @param[in] func Callable object.
+   */
+  template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, TaskFunction> &&
+                                                    std::is_invocable_v<std::decay_t<F>&>>>
+  TaskFunction(F&& func)
+  {
+    using FuncT = std::decay_t<F>;
+    if constexpr (is_inplace<FuncT>()) {
+      ::new (static_cast<void*>(_buffer)) FuncT(std::forward<F>(func));
+      _ops = &inplace_ops<FuncT>;
+    } else {
+      ::new (static_cast<void*>(_buffer)) FuncT*(new FuncT(std::forward<F>(func)));
+      _ops = &heap_ops<FuncT>;
+    }
+  }
+
+  /**
+   * @brief Move ctor.
+   * @param other Moved object, it becomes empty.
+   */
+  TaskFunction(TaskFunction&& other) noexcept : _ops(other._ops)
+  {
+    if (_ops) {
+      _ops->move(_buffer, other._buffer);
+      other._ops = nullptr;
+    }
+  }
+
+  /**
+   * @brief Move assignment operator.
+   * @param other Moved object, it becomes empty.
+   * @return TaskFunction&
+   */
+  TaskFunction& operator=(TaskFunction&& other) noexcept
+  {
+    if (this != &other) {
+      reset();
+      if (other._ops) {
+        other._ops->move(_buffer, other._buffer);
+        _ops = other._ops;
+        other._ops = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Copy ctor.
+   * This constructor was deleted.
+   */
+  TaskFunction(const TaskFunction&) = delete;
+
+  /**
+   * @brief Copy assignment operator.
+   * This opetator was deleted.
+   * @return TaskFunction&
+   */
+  TaskFunction& operator=(const TaskFunction&) = delete;
+
+  /**
+   * @brief Destroy the TaskFunction object and wrapped callable object.
+   */
+  ~TaskFunction() { reset(); }
+
+  /**
+   * @brief Call wrapped callable object. The wrapper must not be empty.
+   */
+  void operator()() { _ops->invoke(_buffer); }
+
+  /**
+   * @brief Checks for a wrapped callable object.
+   * @return true If callable object is wrapped.
+   * @return false If the wrapper is empty.
+   */
+  explicit operator bool() const noexcept { return _ops != nullptr; }
+
+  /**
+   * @brief Destroy wrapped callable object. The wrapper becomes empty.
+   */
+  void reset() noexcept
+  {
+    if (_ops) {
+      _ops->destroy(_buffer);
+      _ops = nullptr;
+    }
+  }
+
+private:
+  /**
+   * @brief Type specific operations over stored callable object.
+   */
+  struct Operations {
+    void (*invoke)(void* storage);
+    void (*move)(void* to, void* from) noexcept;
+    void (*destroy)(void* storage) noexcept;
+  };
+
+  /**
+   * @brief Checks that callable object of the type can be stored in the inline buffer.
+   * @tparam FuncT Callable object type.
+   */
+  template <typename FuncT>
+  static constexpr bool is_inplace()
+  {
+    return sizeof(FuncT) <= buffer_size && alignof(std::max_align_t) % alignof(FuncT) == 0 &&
+           std::is_nothrow_move_constructible_v<FuncT>;
+  }
+
+  /**
+   * @brief Operations for callable object stored in the inline buffer.
+   * @tparam FuncT Callable object type.
+   */
+  template <typename FuncT>
+  static constexpr Operations inplace_ops = {
+    [](void* storage) { (*std::launder(static_cast<FuncT*>(storage)))(); },
+    [](void* to, void* from) noexcept {
+      auto pfrom = std::launder(static_cast<FuncT*>(from));
+      ::new (to) FuncT(std::move(*pfrom));
+      pfrom->~FuncT();
+    },
+    [](void* storage) noexcept { std::launder(static_cast<FuncT*>(storage))->~FuncT(); }};
+
+  /**
+   * @brief Operations for callable object stored in the heap, the inline buffer keeps pointer to it.
+   * @tparam FuncT Callable object type.
+   */
+  template <typename FuncT>
+  static constexpr Operations heap_ops = {
+    [](void* storage) { (**std::launder(static_cast<FuncT**>(storage)))(); },
+    [](void* to, void* from) noexcept { ::new (to) FuncT*(*std::launder(static_cast<FuncT**>(from))); },
+    [](void* storage) noexcept { delete *std::launder(static_cast<FuncT**>(storage)); }};
+
+  /**
+   * @brief Inline buffer for callable object or pointer to it.
+   */
+  alignas(std::max_align_t) unsigned char _buffer[buffer_size];
+  /**
+   * @brief Operations for stored callable object, nullptr if the wrapper is empty.
+   */
+  const Operations* _ops;
+};
+}  // namespace core
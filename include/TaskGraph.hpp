@@ -0,0 +1,178 @@
+#pragma once
+
+#include "ThreadPool.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace core {
+
+/**
+ * @brief This class represent directed acyclic graph of tasks executed by a thread pool.
+ * A node is pushed to the pool as soon as all its predecessors are finished, so tasks never block
+ * pool threads waiting for each other. Readiness is tracked by atomic predecessor counters.
+ * The graph may be run many times, nodes and edges are not reallocated between runs.
+ * If a node throws, functions of the nodes not started yet are skipped and the first exception is
+ * rethrown by wait().
+ */
+class TaskGraph {
+public:
+  using NodeId = std::size_t;
+
+  /**
+   * @brief Construct a new empty TaskGraph object.
+   */
+  TaskGraph();
+
+  /**
+   * @brief Destroy the TaskGraph object. Waits for the current run to finish.
+   */
+  ~TaskGraph();
+
+  /**
+   * @brief Copy ctor.
+   * This constructor was deleted.
+   */
+  TaskGraph(const TaskGraph&) = delete;
+
+  /**
+   * @brief Copy assignment operator.
+   * This opetator was deleted.
+   * @return TaskGraph&
+   */
+  TaskGraph& operator=(const TaskGraph&) = delete;
+
+  /**
+   * @brief Add node to the graph. Must not be called while the graph is running.
+   * @tparam F Function object without arguments, it is called once per run.
+   * @param func Node function.
+   * @param priority Priority of the node task.
+   * @return NodeId Id of the node.
+   */
+  template <typename F>
+  NodeId add_node(F&& func, TaskPriority priority = TaskPriority::Medium)
+  {
+    _nodes.emplace_back(TaskFunction(std::forward<F>(func)), priority);
+    _validated = false;
+    return _nodes.size() - 1;
+  }
+
+  /**
+   * @brief Add edge to the graph: node "to" is started after node "from" is finished.
+   * Must not be called while the graph is running.
+   * @param from Predecessor node id.
+   * @param to Successor node id.
+   * @throw std::out_of_range If node id is invalid.
+   * @throw std::invalid_argument If from and to are the same node.
+   */
+  void add_edge(NodeId from, NodeId to);
+
+  /**
+   * @brief Return number of nodes.
+   * @return std::size_t Number of nodes.
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Start the graph in the thread pool. Returns without waiting, call wait() to wait for completion.
+   * Nodes without predecessors are pushed to the pool at once. If the pool rejects a node task,
+   * the node is executed in the calling thread.
+   * @param pool Thread pool.
+   * @throw std::logic_error If the graph is already running or contains a cycle.
+   */
+  void run(ThreadPool& pool);
+
+  /**
+   * @brief Wait until all nodes of the current run are finished.
+   * @throw Rethrows the first exception thrown by node functions.
+   */
+  void wait();
+
+private:
+  /**
+   * @brief Graph node.
+   */
+  struct Node {
+    Node(TaskFunction&& node_func, TaskPriority node_priority)
+      : func(std::move(node_func)), priority(node_priority), predecessors(0), pending(0)
+    {
+    }
+
+    TaskFunction func;
+    TaskPriority priority;
+    std::vector<NodeId> successors;
+    std::size_t predecessors;
+    std::atomic<std::size_t> pending;
+  };
+
+  /**
+   * @brief Check that the graph has no cycles (Kahn's algorithm).
+   * @throw std::logic_error If the graph contains a cycle.
+   */
+  void validate();
+
+  /**
+   * @brief Push node task to the pool, execute the node in the calling thread if the pool rejects it.
+   * @param id Node id.
+   */
+  void schedule(NodeId id);
+
+  /**
+   * @brief Execute the node and release its successors. One ready successor is executed
+   * in the same thread without going through the pool queue.
+   * @param id Node id.
+   */
+  void execute(NodeId id);
+
+  /**
+   * @brief Graph nodes. Deque keeps node addresses stable when nodes are added.
+   */
+  std::deque<Node> _nodes;
+  /**
+   * @brief Ids of nodes without predecessors.
+   */
+  std::vector<NodeId> _roots;
+  /**
+   * @brief Thread pool of the current run.
+   */
+  ThreadPool* _pool;
+  /**
+   * @brief Number of unfinished nodes of the current run.
+   */
+  std::atomic<std::size_t> _remaining;
+  /**
+   * @brief Becomes true when a node throws, remaining node functions are skipped.
+   */
+  std::atomic_bool _failed;
+  /**
+   * @brief The first exception thrown by node functions.
+   */
+  std::exception_ptr _error;
+  /**
+   * @brief Mutex for saving exception.
+   */
+  std::mutex _error_mutex;
+  /**
+   * @brief Mutex for run state.
+   */
+  std::mutex _done_mutex;
+  /**
+   * @brief Condition variable for waiting the end of the run.
+   */
+  std::condition_variable _done_cv;
+  /**
+   * @brief True while the graph is running. Reset by the thread which finished the last node.
+   */
+  bool _running;
+  /**
+   * @brief True if the graph was checked for cycles after the last modification.
+   */
+  bool _validated;
+};
+}  // namespace core
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Task.hpp"
+
+#include <array>
+#include <cstdint>
+#include <deque>
+
+namespace core {
+
+/**
+ * @brief This class represent FIFO task lanes, one per priority level, with the bitmap of non-empty lanes.
+ * All operations take O(1) time. The class is not thread safe, the owner has to guard it.
+ */
+class TaskLanes {
+public:
+  /**
+   * @brief Construct a new empty TaskLanes object.
+   */
+  TaskLanes();
+
+  /**
+   * @brief Enqueue task to the back of its priority lane.
+   * @param[in] task
+   */
+  void push_back(Task&& task);
+
+  /**
+   * @brief Extract the oldest task from the highest non-empty lane.
+   * @param[out] task Extracted task.
+   * @return true If task was extracted.
+   * @return false If all lanes are empty.
+   */
+  bool pop_front(Task& task);
+
+  /**
+   * @brief Extract the newest task from the highest non-empty lane.
+   * @param[out] task Extracted task.
+   * @return true If task was extracted.
+   * @return false If all lanes are empty.
+   */
+  bool pop_back(Task& task);
+
+  /**
+   * @brief Extract the oldest task from the lowest non-empty lane.
+   * @param[out] task Extracted task.
+   * @return true If task was extracted.
+   * @return false If all lanes are empty.
+   */
+  bool pop_front_lowest(Task& task);
+
+  /**
+   * @brief Extract the oldest task from the lowest non-empty lane if its priority is not higher than the given one.
+   * @param[out] task Extracted task.
+   * @param[in] max_priority Max priority of the extracted task.
+   * @return true If task was extracted.
+   * @return false If all lanes are empty or the lowest non-empty lane is higher than max_priority.
+   */
+  bool pop_front_lowest(Task& task, TaskPriority max_priority);
+
+  /**
+   * @brief Check that some lane below the highest non-empty lane has tasks.
+   * @return true If tasks with different priorities are waiting.
+   * @return false Otherwise.
+   */
+  bool has_lower_lanes() const;
+
+  /**
+   * @brief Check all lanes are empty.
+   * @return true If all lanes are empty.
+   * @return false Otherwise.
+   */
+  bool empty() const;
+
+  /**
+   * @brief Clear all lanes.
+   */
+  void clear();
+
+private:
+  /**
+   * @brief Return index of the highest non-empty lane. Lanes must not be empty.
+   * @return std::size_t Lane index.
+   */
+  std::size_t highest_lane() const;
+
+  /**
+   * @brief Return index of the lowest non-empty lane. Lanes must not be empty.
+   * @return std::size_t Lane index.
+   */
+  std::size_t lowest_lane() const;
+
+  /**
+   * @brief Remove the front task of the lane and update lanes bitmap.
+   * @param lane Lane index.
+   * @param[out] task Extracted task.
+   */
+  void take_front(std::size_t lane, Task& task);
+
+  /**
+   * @brief Represents task lanes, index is equal to priority value.
+   */
+  std::array<std::deque<Task>, task_priority_count> _lanes;
+  /**
+   * @brief Bitmap of non-empty lanes, bit index is equal to lane index.
+   */
+  std::uint32_t _mask;
+};
+}  // namespace core
@@ -1,13 +1,29 @@
 #pragma once
 
-#include "Task.hpp"
+#include "TaskDeadlineHeap.hpp"
+#include "TaskLanes.hpp"
+#include "TaskRing.hpp"
 
+#include <atomic>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <condition_variable>
+#include <span>
 
 namespace core {
 
+/**
+ * @brief Enum class for selecting task queue implementation.
+ * Locked - FIFO lanes, one per priority level, guarded by mutex. Waiting threads sleep on condition variable.
+ * LockFree - lock-free bounded ring with one FIFO lane per priority level, lanes share max queue size task slots
+ * (see TaskRing). Requires max queue size in range [1, TaskRing::max_capacity]. Memory is allocated up front,
+ * about sizeof(Task) + 48 bytes per task of max queue size, see TaskRing::footprint().
+ * Waiting threads sleep on atomic wait and are woken up only if they exist.
+ * Deadline - earliest-deadline-first heap guarded by mutex, see TaskDeadlineHeap. Tasks without deadline
+ * are extracted after tasks with deadline in the order of priority.
+ */
+enum class TaskQueueType : std::uint8_t { Locked, LockFree, Deadline };
+
 /**
  * @brief This class represent Task safe-queue implementation.
  *
@@ -19,16 +35,37 @@ public:
    * factor for task pushing, set 0.
    * @param[in] max_queue_size Max queue size. If current queue size equal max size,
    * then n + 1 task cannot be enqueued.
+   * @param[in] type Queue implementation.
+   * @throw std::invalid_argument If lock-free queue is requested with max queue size equal 0
+   * or greater than TaskRing::max_capacity.
    */
-  TaskQueue(std::uint32_t max_queue_size = 0);
+  TaskQueue(std::uint32_t max_queue_size = 0, TaskQueueType type = TaskQueueType::Locked);
 
   /**
    * @brief Enqueue task to task queue.
-   * @param[in] task
+   * @param[in] task Task is moved from only if enqueuing was successful.
    * @return true If enqueuing was successful.
    * @return false Otherwise.
    */
-  bool push(const Task& task);
+  bool push(Task&& task);
+
+  /**
+   * @brief Enqueue tasks under one critical section and wake up at most as many waiting threads
+   * as tasks were enqueued. If the queue has not enough space, only the first tasks are enqueued.
+   * @param[in] tasks Tasks to enqueue. Only enqueued tasks are moved from.
+   * @return std::size_t Number of enqueued tasks.
+   */
+  std::size_t push_bulk(std::span<Task> tasks);
+
+  /**
+   * @brief Enqueue task in place of the oldest task with the lowest priority, if that priority is not higher
+   * than the priority of the enqueued task. Queue size is not changed, so the task is enqueued even if the queue is full.
+   * @param[in] task Task is moved from only if enqueuing was successful.
+   * @param[out] evicted Removed task.
+   * @return true If a task was evicted and the passed task was enqueued.
+   * @return false If the queue is empty or all queued tasks have higher priority.
+   */
+  bool replace_lowest(Task&& task, Task& evicted);
 
   /**
    * @brief Extract next task for executing.
@@ -36,6 +73,14 @@ public:
    */
   Task pop();
 
+  /**
+   * @brief Extract next task for executing without waiting for it.
+   * @param[out] task Extracted task.
+   * @return true If task was extracted.
+   * @return false If the queue is empty.
+   */
+  bool try_pop(Task& task);
+
   /**
    * @brief Executable thread does not wait while a next task won't be inserted.
    */
@@ -64,7 +109,72 @@ public:
    */
   void clear();
 
+  /**
+   * @brief Return queue implementation type.
+   * @return TaskQueueType Queue type.
+   */
+  TaskQueueType type() const;
+
+  /**
+   * @brief Set anti-starvation policy. After the given number of tasks in a row was extracted
+   * while tasks with lower priority were waiting, the next extracted task is the oldest one from
+   * the lowest non-empty priority level. For lock-free queue the number is counted approximately.
+   * @param[in] limit Number of extractions lower priority tasks can wait for. 0 disables the policy.
+   */
+  void set_starvation_limit(std::uint32_t limit);
+
+  /**
+   * @brief Return anti-starvation limit.
+   * @return std::uint32_t Anti-starvation limit, 0 if the policy is disabled.
+   */
+  std::uint32_t starvation_limit() const;
+
 private:
+  /**
+   * @brief Enqueue task to the lock-free rings.
+   * @param[in] task
+   * @return true If enqueuing was successful.
+   * @return false Otherwise.
+   */
+  bool push_lock_free(Task&& task);
+
+  /**
+   * @brief Extract next task from the lock-free rings without waiting.
+   * @param[out] task Extracted task.
+   * @return true If task was extracted.
+   * @return false If the rings are empty.
+   */
+  bool try_pop_lock_free(Task& task);
+
+  /**
+   * @brief Reserve places for tasks in the lock-free rings.
+   * @param count Number of requested places.
+   * @return std::uint32_t Number of reserved places, may be less than requested.
+   */
+  std::uint32_t reserve(std::uint32_t count);
+
+  /**
+   * @brief Wake up threads waiting in pop(), if there are any. Used by lock-free queue.
+   * @param count Max number of threads to wake up.
+   */
+  void wake_waiters(std::size_t count);
+
+  /**
+   * @brief Extract next task from the lanes according to anti-starvation policy. Mutex must be locked.
+   * @param[out] task Extracted task.
+   */
+  void take_task(Task& task);
+
+  /**
+   * @brief Call the function with the task container of the mutex guarded queue. Mutex must be locked.
+   * @param func Function object taking TaskLanes& or TaskDeadlineHeap&.
+   */
+  template <typename F>
+  decltype(auto) visit_locked(F&& func)
+  {
+    return _type == TaskQueueType::Deadline ? func(_deadline_queue) : func(_task_queue);
+  }
+
   /**
    * @brief Presents thread barrier until the queue is empty or the is_released flag is set.
    */
@@ -74,9 +184,13 @@ private:
    */
   mutable std::mutex _mutex;
   /**
-   * @brief Represents the priority queue for incoming tasks.
+   * @brief Represents the priority lanes for incoming tasks.
    */
-  std::priority_queue<Task, std::vector<Task>, TaskComparator> _task_queue;
+  TaskLanes _task_queue;
+  /**
+   * @brief Represents the deadline heap for incoming tasks. Used by deadline queue only.
+   */
+  TaskDeadlineHeap _deadline_queue;
   /**
    * @brief Represents current queue size.
    */
@@ -91,5 +205,30 @@ private:
    * If current queue size equal max queue size, task pushing is ignored.
    */
   const std::uint32_t _max_queue_size;
+  /**
+   * @brief Queue implementation type.
+   */
+  const TaskQueueType _type;
+  /**
+   * @brief Represents lock-free ring for incoming tasks with one lane per priority level.
+   * Used by lock-free queue only.
+   */
+  std::unique_ptr<TaskRing> _ring;
+  /**
+   * @brief Number of threads waiting for incoming tasks.
+   */
+  std::atomic_uint _waiters;
+  /**
+   * @brief Counter changed on every wake up of waiting threads. Used by lock-free queue only.
+   */
+  std::atomic<std::uint32_t> _wake_epoch;
+  /**
+   * @brief Anti-starvation limit, 0 if the policy is disabled.
+   */
+  std::atomic_uint _starvation_limit;
+  /**
+   * @brief Number of extractions in a row that bypassed waiting lower priority tasks.
+   */
+  std::atomic_uint _bypass_count;
 };
 }  // namespace core
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "Task.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace core {
+
+/**
+ * @brief This class represent lock-free bounded multi-producer multi-consumer ring of tasks with FIFO lanes.
+ * Tasks of all lanes are stored in one array of capacity slots. Lanes and the list of free slots are rings
+ * of slot indices, every index slot keeps a sequence number which tells producers and consumers whether the slot
+ * is free or filled for the current lap (D. Vyukov's bounded MPMC queue).
+ * Memory is allocated up front: capacity tasks plus 8 bytes per index slot for every lane and the free list,
+ * index rings are rounded up to the power of two.
+ */
+class TaskRing {
+public:
+  /**
+   * @brief Max ring capacity.
+   */
+  static constexpr std::uint32_t max_capacity = std::uint32_t{1} << 30;
+
+  /**
+   * @brief Construct a new Task Ring object.
+   * @param[in] capacity Number of task slots shared by all lanes.
+   * @param[in] lane_count Number of lanes.
+   * @throw std::invalid_argument If capacity is 0 or greater than max_capacity, or lane_count is 0.
+   */
+  explicit TaskRing(std::uint32_t capacity, std::size_t lane_count = 1);
+
+  /**
+   * @brief Copy ctor.
+   * This constructor was deleted.
+   */
+  TaskRing(const TaskRing&) = delete;
+
+  /**
+   * @brief Copy assignment operator.
+   * This opetator was deleted.
+   * @return TaskRing&
+   */
+  TaskRing& operator=(const TaskRing&) = delete;
+
+  /**
+   * @brief Enqueue task to the lane.
+   * @param[in] task Task is moved from only if enqueuing was successful.
+   * @param[in] lane Lane index.
+   * @return true If enqueuing was successful.
+   * @return false If all slots are taken.
+   */
+  bool try_push(Task&& task, std::size_t lane = 0);
+
+  /**
+   * @brief Extract the oldest task from the lane.
+   * @param[out] task Extracted task.
+   * @param[in] lane Lane index.
+   * @return true If task was extracted.
+   * @return false If the lane is empty.
+   */
+  bool try_pop(Task& task, std::size_t lane = 0);
+
+  /**
+   * @brief Return ring capacity.
+   * @return std::size_t Number of task slots shared by all lanes.
+   */
+  std::size_t capacity() const;
+
+  /**
+   * @brief Return number of lanes.
+   * @return std::size_t Lane count.
+   */
+  std::size_t lane_count() const;
+
+  /**
+   * @brief Return memory allocated by a ring.
+   * @param[in] capacity Number of task slots.
+   * @param[in] lane_count Number of lanes.
+   * @return std::size_t Allocated bytes.
+   */
+  static std::size_t footprint(std::uint32_t capacity, std::size_t lane_count = 1);
+
+private:
+  /**
+   * @brief Lock-free bounded ring of slot indices.
+   */
+  class IndexRing {
+  public:
+    /**
+     * @brief Index slot. Sequence and positions wrap around, they are compared by signed difference.
+     */
+    struct Slot {
+      std::atomic<std::uint32_t> sequence;
+      std::uint32_t index;
+    };
+
+    /**
+     * @brief Allocate the ring.
+     * @param capacity Ring capacity, power of two.
+     */
+    void init(std::uint32_t capacity);
+
+    bool try_push(std::uint32_t index);
+
+    bool try_pop(std::uint32_t& index);
+
+  private:
+    std::unique_ptr<Slot[]> _slots;
+    std::uint32_t _mask = 0;
+    /**
+     * @brief Position for the next enqueued index.
+     */
+    alignas(64) std::atomic<std::uint32_t> _enqueue_pos{0};
+    /**
+     * @brief Position for the next extracted index.
+     */
+    alignas(64) std::atomic<std::uint32_t> _dequeue_pos{0};
+  };
+
+  /**
+   * @brief Task slots shared by all lanes.
+   */
+  std::unique_ptr<Task[]> _tasks;
+  /**
+   * @brief Number of task slots.
+   */
+  const std::uint32_t _capacity;
+  /**
+   * @brief Number of lanes.
+   */
+  const std::size_t _lane_count;
+  /**
+   * @brief Indices of free task slots.
+   */
+  IndexRing _free;
+  /**
+   * @brief Indices of filled task slots, one ring per lane.
+   */
+  std::unique_ptr<IndexRing[]> _lanes;
+};
+}  // namespace core
@@ -1,26 +1,101 @@
 #pragma once
 
+#include "CpuTopology.hpp"
+#include "ParallelRange.hpp"
 #include "TaskQueue.hpp"
+#include "ThreadPoolMetrics.hpp"
+#include "WorkStealingQueue.hpp"
 
+#include <algorithm>    // std::max, std::min
 #include <atomic>       // std::atomic
 #include <chrono>       // std::chrono
+#include <coroutine>    // std::coroutine_handle
 #include <cstdint>      // std::int_fast64_t, std::uint_fast32_t
+#include <exception>    // std::exception_ptr
 #include <functional>   // std::function
 #include <future>       // std::future, std::promise
 #include <iostream>     // std::cout, std::ostream
 #include <memory>       // std::shared_ptr, std::unique_ptr
 #include <mutex>        // std::mutex, std::scoped_lock
+#include <optional>     // std::optional
 #include <queue>        // std::queue
+#include <span>         // std::span
 #include <thread>       // std::this_thread, std::thread
 #include <type_traits>  // std::common_type_t, std::decay_t, std::enable_if_t, std::is_void_v, std::invoke_result_t
 #include <utility>      // std::move
+#include <vector>       // std::vector
 
 namespace core {
 
+/**
+ * @brief Enum class for selecting how tasks are distributed between the pool threads.
+ * SharedQueue - all threads extract tasks from one shared priority queue.
+ * WorkStealing - every thread owns a local deque. Tasks pushed from a pool thread go to its
+ * local deque, tasks pushed from outside go to the shared injection queue. An idle thread
+ * takes tasks from its local deque (LIFO), then from the injection queue, then steals from
+ * a random victim (FIFO). Priority order is kept inside every queue.
+ * NumaWorkStealing - work-stealing with threads grouped into sub-pools by NUMA node. Every thread is pinned
+ * to the CPUs of its node, tasks pushed from outside by a thread running on the node CPUs go to the node
+ * injection queue. An idle thread takes tasks from its local deque, the node queue and deques of the node threads,
+ * then from the shared injection queue, and only then from queues and deques of other nodes.
+ */
+enum class SchedulingPolicy : std::uint8_t { SharedQueue, WorkStealing, NumaWorkStealing };
+
+/**
+ * @brief Enum class for selecting what the thread pool does with a task pushed when the queue is full.
+ * Reject - the task is not pushed, push returns false.
+ * Block - the pushing thread waits for free space up to the overflow timeout, then the task is rejected.
+ * CallerRuns - the task is executed by the pushing thread, push returns true.
+ * DropOldest - the oldest queued task with the lowest priority is removed and destroyed to free space,
+ * if its priority is not higher than the priority of the pushed task. Otherwise the task is rejected.
+ * With work-stealing policy only tasks of the injection queues are removed. A removed task which is not droppable
+ * (see Task::set_droppable()) is executed by the pushing thread instead of being destroyed.
+ * Throw - the task is not pushed, std::overflow_error is thrown.
+ * The policy is not applied by try_push_task() and try_push_tasks(), which task graphs and coroutine scheduling use.
+ * Event notifications push via push_tasks_nothrow(), which rejects instead of throwing.
+ */
+enum class OverflowPolicy : std::uint8_t { Reject, Block, CallerRuns, DropOldest, Throw };
+
+/**
+ * @brief Enum class for selecting what the thread pool does with a task whose deadline has passed
+ * before the task was started.
+ * Run - the task is executed and counted as expired.
+ * Drop - the task is destroyed without execution and counted as expired, its future reports broken promise.
+ * Tasks which are not droppable (see Task::set_droppable()) are executed.
+ */
+enum class ExpiredTaskPolicy : std::uint8_t { Run, Drop };
+
+/**
+ * @brief Counters of the overflow policy.
+ */
+struct OverflowStats {
+  /**
+   * @brief Number of rejected tasks, including tasks rejected after blocking and thrown errors.
+   */
+  std::uint64_t rejected = 0;
+  /**
+   * @brief Number of pushes which waited for free space.
+   */
+  std::uint64_t blocked = 0;
+  /**
+   * @brief Number of pushes which were rejected after waiting for the overflow timeout.
+   */
+  std::uint64_t timed_out = 0;
+  /**
+   * @brief Number of tasks executed by the pushing thread, including rejected tasks which are not droppable.
+   */
+  std::uint64_t caller_runs = 0;
+  /**
+   * @brief Number of queued tasks removed to free space.
+   */
+  std::uint64_t dropped = 0;
+};
+
 class ThreadPool {
 public:
   using SharedPtr = std::shared_ptr<ThreadPool>;
   using UniquePtr = std::unique_ptr<ThreadPool>;
+  using ErrorHandler = std::function<void(std::exception_ptr)>;
   /**
    * @brief Construct a new thread pool.
    *
@@ -29,8 +104,16 @@ public:
    * If the argument is zero, the default value will be used instead.
    * @param max_task_queue_size The maximum number of tasks in the queue.
    *  The task is added if the queue is not full otherwise false is returned
+   * @param policy Task distribution policy between the threads.
+   * @param queue_type Task queue implementation. Lock-free queue requires max_task_queue_size greater than 0
+   * and allocates max_task_queue_size task slots up front, see TaskQueueType. With NUMA work-stealing policy
+   * every node queue allocates its own slots.
+   * @param numa_nodes Nodes used by NUMA work-stealing policy, empty means nodes of the machine, see CpuTopology.
+   * Nodes may be set explicitly to use a part of the machine or to group CPUs sharing a cache.
    */
-  ThreadPool(std::uint32_t thread_count, std::uint32_t max_task_queue_size);
+  ThreadPool(std::uint32_t thread_count, std::uint32_t max_task_queue_size,
+             SchedulingPolicy policy = SchedulingPolicy::SharedQueue, TaskQueueType queue_type = TaskQueueType::Locked,
+             std::vector<NumaNode> numa_nodes = {});
 
   /**
    * @brief Destruct the thread pool. Waits for all tasks to complete, then destroys all threads. Note that if the
@@ -66,15 +149,297 @@ public:
    */
   std::uint32_t get_thread_count() const;
 
+  /**
+   * @brief Get the number of times a task was picked up by the thread which created it.
+   * Such tasks are executed in place or rescheduled according to their execution policy.
+   *
+   * @return The number of reentrant task executions.
+   */
+  std::uint64_t get_reentrant_task_count() const;
+
+  /**
+   * @brief Aggregate metrics of the workers without stopping them. Counters updated during the call may be
+   * partially included. Metrics are reset by reset(). Must not be called concurrently with reset().
+   *
+   * @return The metrics snapshot, empty if the library is built without metrics.
+   */
+  ThreadPoolMetrics get_metrics() const;
+
+  /**
+   * @brief Get the task distribution policy of the pool.
+   *
+   * @return The scheduling policy.
+   */
+  SchedulingPolicy get_scheduling_policy() const;
+
+  /**
+   * @brief Get the NUMA nodes threads are grouped by. Used by NUMA work-stealing policy only.
+   *
+   * @return The nodes, empty for other policies.
+   */
+  const std::vector<NumaNode>& get_numa_nodes() const;
+
+  /**
+   * @brief Get the node the thread belongs to. Used by NUMA work-stealing policy only.
+   *
+   * @param index Index of the thread in the pool.
+   * @return The index of the node in get_numa_nodes(), 0 for other policies.
+   */
+  std::uint32_t get_thread_numa_node(std::uint32_t index) const;
+
+  /**
+   * @brief Pin the threads to the CPUs via pthread_setaffinity_np(): thread i runs on cpus[i % cpus.size()] only.
+   * Running threads are pinned at once, threads created by reset() are pinned on start. With NUMA work-stealing
+   * policy a thread belongs to the node of its CPU, running threads change their node on reset().
+   * Must not be called concurrently with reset().
+   *
+   * @param cpus CPU numbers. Empty list stops pinning new threads, running threads keep their affinity.
+   * @return true If all running threads were pinned.
+   * @return false If pinning is not supported or a CPU is not available to the process.
+   */
+  bool set_cpu_affinity(std::vector<std::uint32_t> cpus);
+
+  /**
+   * @brief Get the CPUs the threads are pinned to.
+   *
+   * @return The CPU numbers, empty if the threads are not pinned explicitly.
+   */
+  std::vector<std::uint32_t> get_cpu_affinity() const;
+
+  /**
+   * @brief Get the task queue implementation of the pool.
+   *
+   * @return The task queue type.
+   */
+  TaskQueueType get_task_queue_type() const;
+
+  /**
+   * @brief Set anti-starvation policy for the shared task queue, see TaskQueue::set_starvation_limit().
+   * Local deques of work-stealing policy are not affected.
+   *
+   * @param limit Number of extractions lower priority tasks can wait for. 0 disables the policy.
+   */
+  void set_starvation_limit(std::uint32_t limit);
+
+  /**
+   * @brief Set what the pool does with tasks pushed when the queue is full. Applies to bounded queues only.
+   *
+   * @param policy Overflow policy.
+   * @param timeout Max waiting time of Block policy.
+   */
+  void set_overflow_policy(OverflowPolicy policy, std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+  /**
+   * @brief Get the overflow policy of the pool.
+   *
+   * @return The overflow policy.
+   */
+  OverflowPolicy get_overflow_policy() const;
+
+  /**
+   * @brief Get the counters of the overflow policy.
+   *
+   * @return The overflow counters.
+   */
+  OverflowStats get_overflow_stats() const;
+
+  /**
+   * @brief Set what the pool does with tasks started after their deadline, see Task::set_deadline().
+   *
+   * @param policy Expired task policy.
+   */
+  void set_expired_task_policy(ExpiredTaskPolicy policy);
+
+  /**
+   * @brief Get the expired task policy of the pool.
+   *
+   * @return The expired task policy.
+   */
+  ExpiredTaskPolicy get_expired_task_policy() const;
+
+  /**
+   * @brief Get the number of tasks picked up after their deadline, both executed and dropped.
+   *
+   * @return The number of expired tasks.
+   */
+  std::uint64_t get_expired_task_count() const;
+
   /**
    * @brief Push a function with no arguments or return value into the task queue.
+   * If the queue is full, the task is handled according to the overflow policy.
    *
    * @tparam Task packed callable task.
-   * @param task The function to push.
+   * @param task The function to push. It is moved from only if push finished successfully.
+   * @return bool Return true if push finished successfully or the task was executed by the calling thread,
+   * false otherwise(current queue size more or equal task queue capacity)
+   * @throw std::overflow_error If the queue is full and the overflow policy is Throw.
+   */
+  bool push_task(Task&& task);
+
+  /**
+   * @brief Push several tasks into the task queue under one critical section. At most as many
+   * sleeping threads are woken up as tasks were pushed. Tasks which do not fit the queue are handled
+   * one by one according to the overflow policy until one of them is rejected.
+   *
+   * @param tasks The tasks to push. Only pushed tasks are moved from.
+   * @return std::size_t Number of pushed tasks. If the queue has not enough space, only the first tasks are pushed.
+   * @throw std::overflow_error If the queue is full and the overflow policy is Throw.
+   */
+  std::size_t push_tasks(std::span<Task> tasks);
+
+  /**
+   * @brief Push several tasks and handle every task which does not fit the queue according to the overflow policy.
+   * Throw policy rejects the task instead of throwing. After the first rejected task the policy is not applied
+   * to the rest of the tasks, they are pushed only if there is free space, so Block policy waits once per call.
+   * Rejected tasks which are not droppable (see Task::set_droppable()) are executed by the calling thread,
+   * as well as all tasks pushed after join_all() was called.
+   *
+   * @param tasks The tasks to push. Rejected tasks are not moved from, their futures report broken promise
+   * when they are destroyed.
+   * @return std::size_t Number of tasks pushed or executed by the calling thread.
+   */
+  std::size_t push_tasks_nothrow(std::span<Task> tasks);
+
+  /**
+   * @brief Push the task into the queue without applying the overflow policy: the calling thread
+   * is never blocked, the task is not executed in place and no exception is thrown.
+   * Intended for callers which execute rejected tasks themselves, e.g. graph nodes and coroutine resumption.
+   *
+   * @param task The task to push. It is moved from only if push finished successfully.
+   * @return true If the task was pushed.
+   * @return false If the queue is full or the pool is joined.
+   */
+  bool try_push_task(Task& task);
+
+  /**
+   * @brief Push several tasks into the task queue under one critical section without applying the overflow policy.
+   *
+   * @param tasks The tasks to push. Only pushed tasks are moved from.
+   * @return std::size_t Number of pushed tasks. If the queue has not enough space, only the first tasks are pushed.
+   */
+  std::size_t try_push_tasks(std::span<Task> tasks);
+
+  /**
+   * @brief Push a function with a variable number of arguments into the task queue without
+   * creating std::promise/std::future. Returning value is ignored, exceptions are passed to the error handler.
+   *
+   * @tparam F Function object or pointer to the member function.
+   * @tparam Args Passed arguments, for member function the first one is pointer to the object.
+   * @param func The function to push.
+   * @param args Passed arguments.
    * @return bool Return true if push finished successfully,
    * false otherwise(current queue size more or equal task queue capacity)
    */
-  bool push_task(const Task& task);
+  template <typename F, typename... Args>
+  bool post(F&& func, Args&&... args)
+  {
+    Task task;
+    task.assign_detached(std::forward<F>(func), std::forward<Args>(args)...);
+    return push_task(std::move(task));
+  }
+
+  /**
+   * @brief Awaitable object returned by schedule().
+   */
+  class ScheduleAwaiter {
+  public:
+    ScheduleAwaiter(ThreadPool& pool, TaskPriority priority) : _pool(pool), _priority(priority) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    /**
+     * @brief Push resumption of the coroutine to the pool.
+     * @return false If the pool rejected the task, the coroutine continues in the current thread.
+     */
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+      Task task(_priority);
+      task.set_droppable(false);
+      task.assign_detached([handle] { handle.resume(); });
+      return _pool.try_push_task(task);
+    }
+
+    void await_resume() const noexcept {}
+
+  private:
+    ThreadPool& _pool;
+    const TaskPriority _priority;
+  };
+
+  /**
+   * @brief Move the calling coroutine to a pool thread: co_await pool.schedule().
+   * If the pool rejects the task, the coroutine continues in the current thread.
+   *
+   * @param priority Priority of the resumption task.
+   * @return ScheduleAwaiter Awaitable object.
+   */
+  ScheduleAwaiter schedule(TaskPriority priority = TaskPriority::Medium) { return ScheduleAwaiter(*this, priority); }
+
+  /**
+   * @brief Call the function for every index of the range [begin, end) in parallel.
+   * The range is split adaptively: participants claim chunks of decreasing size, not less than grain.
+   * The calling thread takes part in the loop, so it may be called from a pool thread.
+   * Completion is tracked by a single latch instead of per-chunk futures.
+   *
+   * @tparam Index Integral index type.
+   * @tparam F Function object taking an index.
+   * @param begin First index.
+   * @param end Index after the last one.
+   * @param grain Min number of indices processed by one participant at once.
+   * @param func The function to call.
+   * @throw Rethrows the first exception thrown by the function, the rest of indices are skipped.
+   */
+  template <typename Index, typename F>
+  void parallel_for(Index begin, Index end, Index grain, F&& func)
+  {
+    parallel_run(begin, end, grain, [&func](Index first, Index last) {
+      for (Index i = first; i < last; ++i) {
+        func(i);
+      }
+    });
+  }
+
+  /**
+   * @brief Reduce the range [begin, end) in parallel.
+   * Every participant accumulates its chunks starting from the identity value, then partial results
+   * are combined by the reduce function. Splitting is the same as in parallel_for().
+   *
+   * @tparam Index Integral index type.
+   * @tparam T Result type.
+   * @tparam F Function object with signature T(Index first, Index last, T init), accumulating a chunk into init.
+   * @tparam R Function object with signature T(T, T). It must be associative and commutative.
+   * @param begin First index.
+   * @param end Index after the last one.
+   * @param grain Min number of indices processed by one participant at once.
+   * @param identity Identity value of the reduce function.
+   * @param func Chunk accumulating function.
+   * @param reduce Reduce function.
+   * @return T Reduced value.
+   * @throw Rethrows the first exception thrown by the functions.
+   */
+  template <typename Index, typename T, typename F, typename R>
+  T parallel_reduce(Index begin, Index end, Index grain, T identity, F&& func, R&& reduce)
+  {
+    T result = identity;
+    std::mutex result_mutex;
+    parallel_run(
+      begin, end, grain,
+      [&func](Index first, Index last, T& partial) { partial = func(first, last, std::move(partial)); },
+      [&reduce, &result, &result_mutex](T& partial) {
+        const std::lock_guard lock(result_mutex);
+        result = reduce(std::move(result), std::move(partial));
+      },
+      identity);
+    return result;
+  }
+
+  /**
+   * @brief Set handler for exceptions thrown by tasks pushed via post() or Task::assign_detached().
+   * Handler calls are serialized, the handler must not throw. If the handler is not set, exceptions are ignored.
+   *
+   * @param handler Error handler.
+   */
+  void set_error_handler(ErrorHandler handler);
 
   /**
    * @brief Interrupts execution of all threads
@@ -126,14 +491,270 @@ private:
    * @brief A worker function to be assigned to each thread in the pool.
    * Continuously pops tasks out of the queue and executes them,
    * as long as the atomic variable running is set to true.
+   * @param index Index of the thread in the pool.
+   */
+  void run(std::uint32_t index);
+
+  /**
+   * @brief A worker function for work-stealing policy.
+   * Searches a task in the local deque, injection queue and deques of other threads,
+   * sleeps if nothing was found.
+   * @param index Index of the thread in the pool.
+   */
+  void run_stealing(std::uint32_t index);
+
+  /**
+   * @brief Search next task for the thread with the given index.
+   * @param index Index of the thread in the pool.
+   * @param[out] task Found task.
+   * @return true If task was found.
+   * @return false Otherwise.
    */
-  void run();
+  bool find_task(std::uint32_t index, Task& task);
+
+  /**
+   * @brief Search a task in the node queue and deques of the node threads, then in the shared injection queue
+   * and in other nodes. Used by NUMA work-stealing policy.
+   * @param index Index of the thread in the pool.
+   * @param[out] task Found task.
+   * @return true If task was found.
+   * @return false Otherwise.
+   */
+  bool find_numa_task(std::uint32_t index, Task& task);
+
+  /**
+   * @brief Steal a task from the deque of one of the threads, starting from a random one.
+   * @param index Index of the thief in the pool.
+   * @param victims Indices of the threads to steal from.
+   * @param[out] task Stolen task.
+   * @return true If task was stolen.
+   * @return false Otherwise.
+   */
+  bool steal_task(std::uint32_t index, std::span<const std::uint32_t> victims, Task& task);
+
+  /**
+   * @brief Return the node of the CPU the calling thread is running on. Used by NUMA work-stealing policy.
+   * @return std::int32_t Node index, -1 if the CPU does not belong to the nodes of the pool or the policy is different.
+   */
+  std::int32_t current_node() const;
+
+  /**
+   * @brief Assign the threads to NUMA nodes and select the CPUs they are pinned to.
+   */
+  void place_threads();
+
+  /**
+   * @brief Check the policy uses local deques of the threads.
+   * @return true If the policy is work-stealing.
+   * @return false Otherwise.
+   */
+  bool is_work_stealing() const { return _policy != SchedulingPolicy::SharedQueue; }
+
+  /**
+   * @brief Wake up sleeping threads if there are any. Used by work-stealing policy.
+   * @param count Max number of threads to wake up.
+   */
+  void wake_workers(std::size_t count);
+
+  /**
+   * @brief Notify join_all() that the queues may be empty.
+   */
+  void notify_finish();
+
+  /**
+   * @brief Execute the task and pass its exception to the error handler.
+   * An expired task is handled according to the expired task policy first.
+   * A task picked up by the thread which created it is counted as reentrant and may be
+   * pushed back to the shared queue once if its execution policy is Reschedule.
+   * @param task Executed task.
+   */
+  void execute(Task& task);
+
+  /**
+   * @brief Remember the enqueuing time of the tasks for metrics. Does nothing if metrics are disabled.
+   * @param tasks Enqueued tasks.
+   */
+  void mark_enqueued(std::span<Task> tasks);
+
+  /**
+   * @brief Execute the task in the calling thread and pass its exception to the error handler.
+   * @param task Executed task.
+   */
+  void run_in_caller(Task& task);
+
+  /**
+   * @brief Handle the task which does not fit the queue according to the overflow policy.
+   * Rejection is counted by the caller, except for the thrown error.
+   * @param task The task to push. It is moved from only if it was pushed or executed.
+   * @param may_throw False if Throw policy rejects the task instead of throwing.
+   * @return true If the task was pushed or executed by the calling thread.
+   * @return false If the task was rejected.
+   */
+  bool push_overflowed(Task& task, bool may_throw);
+
+  /**
+   * @brief Wait for free space in the queue up to the overflow timeout and push the task.
+   * @param task The task to push. It is moved from only if push finished successfully.
+   * @return true If the task was pushed.
+   * @return false If the timeout expired or the pool is stopping.
+   */
+  bool push_blocking(Task& task);
+
+  /**
+   * @brief Wake up one thread waiting for free space in the queue, if there is any.
+   * Does nothing for unbounded queues and overflow policies other than Block.
+   */
+  void notify_space();
+
+  /**
+   * @brief Push the task back to the shared queue without changing the number of unfinished tasks.
+   * Enqueuing time and trace flow of the task are updated as for pushed tasks.
+   * @param task Rescheduled task. It is moved from only if push finished successfully.
+   * @return true If the task was pushed.
+   * @return false If the queue is full or the pool is stopping.
+   */
+  bool reschedule(Task& task);
+
+  /**
+   * @brief Run the parallel loop without per-participant state.
+   * @param body Function object taking chunk bounds (first, last).
+   */
+  template <typename Index, typename Body>
+  void parallel_run(Index begin, Index end, Index grain, Body&& body)
+  {
+    struct Stateless {};
+    parallel_run(
+      begin, end, grain, [&body](Index first, Index last, Stateless&) { body(first, last); }, [](Stateless&) {},
+      Stateless{});
+  }
+
+  /**
+   * @brief Run the parallel loop. Pushes helper tasks into the pool and takes part in the loop
+   * in the calling thread. Helpers which start after the range is exhausted return immediately.
+   * @param body Function object taking chunk bounds and participant state (first, last, Local&).
+   * @param finish Function object taking participant state, called after the last chunk of participant.
+   * @param init Initial participant state.
+   */
+  template <typename Index, typename Body, typename Finish, typename Local>
+  void parallel_run(Index begin, Index end, Index grain, Body&& body, Finish&& finish, const Local& init)
+  {
+    static_assert(std::is_integral_v<Index>, "parallel loop requires integral index type");
+    if (!(begin < end)) {
+      return;
+    }
+    grain = std::max<Index>(grain, 1);
+    const auto count = static_cast<std::uint64_t>(end - begin);
+    const auto chunks = (count + static_cast<std::uint64_t>(grain) - 1) / static_cast<std::uint64_t>(grain);
+    const auto helpers = static_cast<std::uint32_t>(std::min<std::uint64_t>(_thread_count, chunks - 1));
+    auto range = std::make_shared<ParallelRange<Index>>(begin, end, grain, helpers + 1);
+    if (helpers != 0) {
+      std::vector<Task> tasks(helpers);
+      for (auto& task : tasks) {
+        // Pointers to the caller's objects are dereferenced only after a chunk is claimed, the caller
+        // waits for all claimed chunks, so late helpers never touch them.
+        task.assign_detached([range, pbody = &body, pfinish = &finish, pinit = &init] {
+          participate(*range, pbody, pfinish, pinit);
+        });
+      }
+      try_push_tasks(tasks);
+    }
+    participate(*range, &body, &finish, &init);
+    range->wait();
+  }
+
+  /**
+   * @brief Process chunks of the range with a participant state created on the first claimed chunk.
+   */
+  template <typename Index, typename Body, typename Finish, typename Local>
+  static void participate(ParallelRange<Index>& range, Body* body, Finish* finish, const Local* init)
+  {
+    std::optional<Local> local;
+    range.run(
+      [&](Index first, Index last) {
+        if (!local) {
+          local.emplace(*init);
+        }
+        (*body)(first, last, *local);
+      },
+      [&] { (*finish)(*local); });
+  }
 
   /**
    * @brief A queue of tasks to be executed by the threads.
+   * For work-stealing policy it is used as injection queue for tasks pushed from outside the pool.
    */
   TaskQueue _tasks;
 
+  /**
+   * @brief Task distribution policy.
+   */
+  const SchedulingPolicy _policy;
+
+  /**
+   * @brief Max number of queued tasks, 0 means unlimited.
+   */
+  const std::uint32_t _max_task_queue_size;
+
+  /**
+   * @brief Local task deques of the threads. Used by work-stealing policy only.
+   */
+  std::unique_ptr<WorkStealingQueue[]> _local_tasks;
+
+  /**
+   * @brief Number of tasks in all local task deques and NUMA node queues.
+   */
+  std::atomic_uint _local_tasks_total;
+
+  /**
+   * @brief NUMA nodes the threads are grouped by. Used by NUMA work-stealing policy only.
+   */
+  std::vector<NumaNode> _numa_nodes;
+
+  /**
+   * @brief Injection queues of the nodes, index is equal to the node index. Used by NUMA work-stealing policy only.
+   */
+  std::vector<std::unique_ptr<TaskQueue>> _node_tasks;
+
+  /**
+   * @brief Node index of every CPU, -1 for CPUs without node. Used by NUMA work-stealing policy only.
+   */
+  std::vector<std::int32_t> _cpu_nodes;
+
+  /**
+   * @brief Node index of every thread. Used by NUMA work-stealing policy only.
+   */
+  std::vector<std::uint32_t> _thread_nodes;
+
+  /**
+   * @brief Thread indices of every node. Work-stealing policy has one group with all threads.
+   */
+  std::vector<std::vector<std::uint32_t>> _node_threads;
+
+  /**
+   * @brief CPUs the threads are pinned to, explicitly set by set_cpu_affinity().
+   */
+  std::vector<std::uint32_t> _cpu_affinity;
+
+  /**
+   * @brief CPUs every thread is pinned to on start, empty if the thread is not pinned.
+   */
+  std::vector<std::vector<std::uint32_t>> _thread_cpus;
+
+  /**
+   * @brief Number of threads sleeping while waiting for tasks. Used by work-stealing policy only.
+   */
+  std::atomic_uint _idle_count;
+
+  /**
+   * @brief Condition variable for sleeping threads. Used by work-stealing policy only.
+   */
+  std::condition_variable _idle_cv;
+
+  /**
+   * @brief Mutex for sleeping threads. Used by work-stealing policy only.
+   */
+  std::mutex _idle_mutex;
+
   /**
    * @brief The number of threads in the pool.
    */
@@ -144,6 +765,18 @@ private:
    */
   std::unique_ptr<std::thread[]> _threads;
 
+#ifdef CORE_ENABLE_METRICS
+  /**
+   * @brief Metrics of the threads, index is equal to the thread index.
+   */
+  std::unique_ptr<WorkerMetrics[]> _worker_metrics;
+
+  /**
+   * @brief Time the threads were created.
+   */
+  std::chrono::steady_clock::time_point _metrics_start;
+#endif
+
   /**
    * @brief Condition variable for pausing thread pool
    *
@@ -168,12 +801,71 @@ private:
    */
   std::mutex _finish_mutex;
 
+  /**
+   * @brief Handler for exceptions thrown by tasks.
+   */
+  ErrorHandler _error_handler;
+
+  /**
+   * @brief Mutex to serialize error handler access.
+   */
+  std::mutex _error_mutex;
+
   /**
    * @brief An atomic variable to keep track of the total number of unfinished tasks -
    * either still in the queue, or running in a thread.
    */
   std::atomic_uint _tasks_total;
 
+  /**
+   * @brief Number of tasks picked up by the thread which created them.
+   */
+  std::atomic<std::uint64_t> _reentrant_tasks;
+
+  /**
+   * @brief Policy for tasks pushed when the queue is full.
+   */
+  std::atomic<OverflowPolicy> _overflow_policy;
+
+  /**
+   * @brief Max waiting time of Block overflow policy.
+   */
+  std::atomic<std::chrono::milliseconds> _overflow_timeout;
+
+  /**
+   * @brief Counters of the overflow policy.
+   */
+  std::atomic<std::uint64_t> _rejected_tasks;
+  std::atomic<std::uint64_t> _blocked_pushes;
+  std::atomic<std::uint64_t> _timed_out_pushes;
+  std::atomic<std::uint64_t> _caller_runs;
+  std::atomic<std::uint64_t> _dropped_tasks;
+
+  /**
+   * @brief Policy for tasks started after their deadline.
+   */
+  std::atomic<ExpiredTaskPolicy> _expired_policy;
+
+  /**
+   * @brief Number of tasks picked up after their deadline.
+   */
+  std::atomic<std::uint64_t> _expired_tasks;
+
+  /**
+   * @brief Number of threads waiting for free space in the queue.
+   */
+  std::atomic_uint _space_waiters;
+
+  /**
+   * @brief Condition variable for threads waiting for free space in the queue.
+   */
+  std::condition_variable _space_cv;
+
+  /**
+   * @brief Mutex for threads waiting for free space in the queue.
+   */
+  std::mutex _space_mutex;
+
   /**
    * @brief An atomic variable indicating to the workers to pause.
    * When set to true, the workers temporarily stop execution tasks,
@@ -19,6 +19,12 @@ public:
     thread_pool_.reset(new ThreadPool(thread_count, max_task_queue_size));
   }
 
+  /**
+   * @brief Get the thread pool used for execution, e.g. to set its overflow policy.
+   * @return ThreadPool* Thread pool, nullptr if it was not initialized.
+   */
+  ThreadPool* get_thread_pool() const { return thread_pool_.get(); }
+
 protected:
   /**
    * @brief Default ctor ThreadPoolExecutable class.
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "LatencyHistogram.hpp"
+#include "Task.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace core {
+
+/**
+ * @brief Metrics of the thread pool aggregated by ThreadPool::get_metrics().
+ * Metrics are collected only if the library is built with ENABLE_METRICS option (CORE_ENABLE_METRICS definition),
+ * otherwise the snapshot is empty.
+ */
+struct ThreadPoolMetrics {
+  /**
+   * @brief Counters of one worker thread.
+   */
+  struct Worker {
+    /**
+     * @brief Number of executed tasks.
+     */
+    std::uint64_t executed = 0;
+    /**
+     * @brief Number of detached tasks which threw an exception, see ThreadPool::post().
+     */
+    std::uint64_t failed = 0;
+    /**
+     * @brief Number of tasks stolen from other workers. Used by work-stealing policy only.
+     */
+    std::uint64_t stolen = 0;
+    /**
+     * @brief Total execution time of the tasks.
+     */
+    std::chrono::nanoseconds busy_time{0};
+    /**
+     * @brief Part of the elapsed time the worker spent executing tasks, in range [0, 1].
+     */
+    double utilisation = 0.0;
+  };
+
+  /**
+   * @brief Time since the workers were created.
+   */
+  std::chrono::nanoseconds elapsed{0};
+  /**
+   * @brief Counters of the workers, index is equal to the worker index.
+   */
+  std::vector<Worker> workers;
+  /**
+   * @brief Time from enqueuing to the start of execution of all workers, index is equal to task priority value.
+   */
+  std::array<LatencyHistogram::Snapshot, task_priority_count> queue_wait;
+  /**
+   * @brief Execution time of all workers, index is equal to task priority value.
+   */
+  std::array<LatencyHistogram::Snapshot, task_priority_count> execution;
+};
+
+/**
+ * @brief Metrics recorded by one worker thread. Only the worker writes them, so recording does not
+ * contend with other workers and snapshots do not stop the worker.
+ */
+struct alignas(64) WorkerMetrics {
+  /**
+   * @brief Increment the counter written by the worker only.
+   */
+  static void add(std::atomic<std::uint64_t>& counter, std::uint64_t value)
+  {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+
+  std::atomic<std::uint64_t> executed{0};
+  std::atomic<std::uint64_t> failed{0};
+  std::atomic<std::uint64_t> stolen{0};
+  std::atomic<std::uint64_t> busy_time{0};
+  std::array<LatencyHistogram, task_priority_count> queue_wait;
+  std::array<LatencyHistogram, task_priority_count> execution;
+};
+}  // namespace core
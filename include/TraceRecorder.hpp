@@ -0,0 +1,289 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace core {
+
+/**
+ * @brief Enum class for connecting trace slices by flow arrows.
+ * None - the slice is not connected.
+ * Out - the slice starts the flow, e.g. task push.
+ * In - the slice ends the flow, e.g. task execution.
+ */
+enum class TraceFlow : std::uint8_t { None, Out, In };
+
+/**
+ * @brief Trace slice recorded by a thread.
+ */
+struct TraceRecord {
+  /**
+   * @brief Slice name, must be a string literal or have static storage duration.
+   */
+  const char* name = nullptr;
+  /**
+   * @brief Slice category, must be a string literal or have static storage duration.
+   */
+  const char* category = nullptr;
+  /**
+   * @brief Start of the slice in nanoseconds of std::chrono::steady_clock.
+   */
+  std::uint64_t timestamp = 0;
+  /**
+   * @brief Duration of the slice in nanoseconds.
+   */
+  std::uint64_t duration = 0;
+  /**
+   * @brief Flow id, 0 if the slice is not connected.
+   */
+  std::uint64_t flow_id = 0;
+  /**
+   * @brief Flow direction.
+   */
+  TraceFlow flow = TraceFlow::None;
+};
+
+/**
+ * @brief This class implement in-process trace recorder exported to Chrome trace JSON,
+ * which may be opened by chrome://tracing or Perfetto UI.
+ * Every thread records slices into its own ring buffer: recording does not take locks and does not write
+ * memory shared with other threads, when the buffer is full the oldest slices are overwritten.
+ * Buffers of finished threads are kept until the recorder is started again or cleared.
+ * Thread pool and event instrumentation is compiled only with ENABLE_TRACING option (CORE_ENABLE_TRACING definition)
+ * and checks is_enabled() before reading the clock, so a stopped recorder costs one relaxed load.
+ */
+class TraceRecorder {
+public:
+  /**
+   * @brief Default number of slices per thread.
+   */
+  static constexpr std::size_t default_capacity = 1 << 16;
+
+  /**
+   * @brief RAII slice of the current thread, recorded when the scope is left.
+   * Does nothing if the library is built without tracing or the recorder is stopped.
+   */
+  class Scope {
+  public:
+    /**
+     * @brief Construct a new Scope object and remember the start time.
+     * @param name Slice name, must be a string literal.
+     * @param category Slice category, must be a string literal.
+     */
+    Scope([[maybe_unused]] const char* name, [[maybe_unused]] const char* category)
+#ifdef CORE_ENABLE_TRACING
+      : _name(name), _category(category), _start(TraceRecorder::instance().is_enabled() ? TraceRecorder::now() : 0)
+#endif
+    {
+    }
+
+    ~Scope()
+    {
+#ifdef CORE_ENABLE_TRACING
+      if (_start != 0) {
+        TraceRecorder::instance().record({_name, _category, _start, TraceRecorder::now() - _start});
+      }
+#endif
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+#ifdef CORE_ENABLE_TRACING
+  private:
+    const char* _name;
+    const char* _category;
+    std::uint64_t _start;
+#endif
+  };
+
+  /**
+   * @brief Return the global recorder. The recorder is never destroyed, so it may be used by any thread at exit.
+   * @return TraceRecorder& Global recorder.
+   */
+  static TraceRecorder& instance();
+
+  /**
+   * @brief Copy ctor.
+   * This constructor was deleted.
+   */
+  TraceRecorder(const TraceRecorder&) = delete;
+
+  /**
+   * @brief Copy assignment operator.
+   * This opetator was deleted.
+   * @return TraceRecorder&
+   */
+  TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+  /**
+   * @brief Drop recorded slices and start recording.
+   * @param capacity Number of slices per thread, rounded up to the power of two.
+   */
+  void start(std::size_t capacity = default_capacity);
+
+  /**
+   * @brief Stop recording. Recorded slices are kept for dump().
+   */
+  void stop();
+
+  /**
+   * @brief Check the recorder is started.
+   * @return true If slices are recorded.
+   * @return false Otherwise.
+   */
+  bool is_enabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Drop recorded slices.
+   */
+  void clear();
+
+  /**
+   * @brief Record the slice in the buffer of the current thread. Does nothing if the recorder is stopped.
+   * @param record Slice.
+   */
+  void record(const TraceRecord& record);
+
+  /**
+   * @brief Return a new flow id, unique until the process exits.
+   * @return std::uint64_t Flow id, never 0.
+   */
+  std::uint64_t next_flow_id() { return _flow_id.fetch_add(1, std::memory_order_relaxed); }
+
+  /**
+   * @brief Set the name of the current thread shown in the trace.
+   * @param name Thread name.
+   */
+  void set_thread_name(std::string name);
+
+  /**
+   * @brief Return slices of all threads. May be called while threads are recording, slices overwritten
+   * during the copy are skipped.
+   * @return std::vector<TraceRecord> Slices ordered by thread and recording order.
+   */
+  std::vector<TraceRecord> records() const;
+
+  /**
+   * @brief Write slices of all threads as Chrome trace JSON. Timestamps are relative to the last start().
+   * @param stream Output stream.
+   */
+  void dump(std::ostream& stream) const;
+
+  /**
+   * @brief Write slices of all threads as Chrome trace JSON file.
+   * @param path File path.
+   * @return true If the file was written.
+   * @return false Otherwise.
+   */
+  bool dump(const std::string& path) const;
+
+  /**
+   * @brief Return current time of the trace clock.
+   * @return std::uint64_t Nanoseconds of std::chrono::steady_clock.
+   */
+  static std::uint64_t now();
+
+private:
+  /**
+   * @brief Ring buffer of one thread. The owner thread is the only writer, readers copy it without stopping the writer.
+   */
+  class Buffer {
+  public:
+    Buffer(std::size_t capacity, std::uint32_t thread_id, std::string thread_name);
+
+    /**
+     * @brief Write the slice, overwrite the oldest one if the buffer is full. Called by the owner thread only.
+     * @param record Slice.
+     */
+    void push(const TraceRecord& record);
+
+    /**
+     * @brief Append slices which were not overwritten during the copy.
+     * @param records Output slices.
+     */
+    void copy(std::vector<TraceRecord>& records) const;
+
+    /**
+     * @brief Thread id shown in the trace.
+     */
+    const std::uint32_t thread_id;
+    /**
+     * @brief Thread name shown in the trace.
+     */
+    std::string thread_name;
+
+  private:
+    /**
+     * @brief Slice fields are atomic, so a slot may be read while the owner overwrites it.
+     * Sequence is the number of the slice written to the slot plus one, 0 while the slot is being written.
+     */
+    struct Slot {
+      std::atomic<std::uint64_t> sequence{0};
+      std::atomic<const char*> name{nullptr};
+      std::atomic<const char*> category{nullptr};
+      std::atomic<std::uint64_t> timestamp{0};
+      std::atomic<std::uint64_t> duration{0};
+      std::atomic<std::uint64_t> flow_id{0};
+      std::atomic<TraceFlow> flow{TraceFlow::None};
+    };
+
+    std::unique_ptr<Slot[]> _slots;
+    const std::size_t _mask;
+    /**
+     * @brief Number of slices written since the buffer was created.
+     */
+    std::atomic<std::uint64_t> _head;
+  };
+
+  friend struct ThreadTrace;
+
+  TraceRecorder();
+
+  /**
+   * @brief Create the buffer of the current thread for the current generation.
+   * @param name Thread name.
+   * @return std::shared_ptr<Buffer> Registered buffer.
+   */
+  std::shared_ptr<Buffer> register_thread(const std::string& name);
+
+  /**
+   * @brief True while the recorder is started.
+   */
+  std::atomic_bool _enabled;
+  /**
+   * @brief Incremented by start() and clear(), threads create new buffers when it changes.
+   */
+  std::atomic<std::uint64_t> _generation;
+  /**
+   * @brief Last flow id.
+   */
+  std::atomic<std::uint64_t> _flow_id;
+  /**
+   * @brief Time of the last start(), trace timestamps are relative to it.
+   */
+  std::atomic<std::uint64_t> _origin;
+  /**
+   * @brief Mutex for buffers list and capacity.
+   */
+  mutable std::mutex _mutex;
+  /**
+   * @brief Number of slices per thread.
+   */
+  std::size_t _capacity;
+  /**
+   * @brief Next thread id shown in the trace.
+   */
+  std::uint32_t _next_thread_id;
+  /**
+   * @brief Buffers of the current generation.
+   */
+  std::vector<std::shared_ptr<Buffer>> _buffers;
+};
+}  // namespace core
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "TaskLanes.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <span>
+
+namespace core {
+
+/**
+ * @brief This class represent per-worker task deque for work-stealing scheduling.
+ * The owner thread pushes and pops tasks from the back (LIFO), other threads
+ * steal tasks from the front (FIFO). Tasks are kept in one lane per priority level,
+ * so higher priority tasks are always extracted first.
+ */
+class WorkStealingQueue {
+public:
+  /**
+   * @brief Construct a new empty WorkStealingQueue object.
+   */
+  WorkStealingQueue();
+
+  /**
+   * @brief Enqueue task to the back of its priority lane. Called by the owner thread.
+   * @param[in] task
+   */
+  void push(Task&& task);
+
+  /**
+   * @brief Enqueue tasks under one critical section. Called by the owner thread.
+   * @param[in] tasks Tasks to enqueue, all of them are moved from.
+   */
+  void push_bulk(std::span<Task> tasks);
+
+  /**
+   * @brief Extract the most recently pushed task with the highest priority.
+   * Called by the owner thread.
+   * @param[out] task Extracted task.
+   * @return true If task was extracted.
+   * @return false If the queue is empty.
+   */
+  bool pop(Task& task);
+
+  /**
+   * @brief Extract the oldest task with the highest priority.
+   * Called by other threads.
+   * @param[out] task Extracted task.
+   * @return true If task was extracted.
+   * @return false If the queue is empty.
+   */
+  bool steal(Task& task);
+
+  /**
+   * @brief Return current queue size.
+   * @return std::uint32_t Queue size.
+   */
+  std::uint32_t size() const;
+
+  /**
+   * @brief Check queue equals 0.
+   * @return true If size equal 0.
+   * @return false Otherwise.
+   */
+  bool empty() const;
+
+  /**
+   * @brief Clear current task queue.
+   */
+  void clear();
+
+private:
+  /**
+   * @brief Mutex for lanes access. Contended only when the queue is stolen from.
+   */
+  mutable std::mutex _mutex;
+  /**
+   * @brief Represents task lanes, one per priority level.
+   */
+  TaskLanes _lanes;
+  /**
+   * @brief Represents current queue size.
+   */
+  std::atomic_uint _size;
+};
+}  // namespace core
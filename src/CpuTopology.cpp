@@ -0,0 +1,122 @@
+#include "CpuTopology.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace core {
+
+std::vector<std::uint32_t> CpuTopology::allowed_cpus()
+{
+  std::vector<std::uint32_t> cpus;
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (std::uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &set)) {
+        cpus.push_back(cpu);
+      }
+    }
+    return cpus;
+  }
+#endif
+  for (std::uint32_t cpu = 0; cpu < std::max(std::thread::hardware_concurrency(), 1u); ++cpu) {
+    cpus.push_back(cpu);
+  }
+  return cpus;
+}
+
+std::vector<NumaNode> CpuTopology::numa_nodes()
+{
+  const auto allowed = allowed_cpus();
+  std::vector<NumaNode> nodes;
+#ifdef __linux__
+  std::error_code error;
+  for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", error)) {
+    const auto name = entry.path().filename().string();
+    if (name.size() <= 4 || name.compare(0, 4, "node") != 0 ||
+        !std::all_of(name.begin() + 4, name.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+      continue;
+    }
+    std::ifstream stream(entry.path() / "cpulist");
+    std::string list;
+    std::getline(stream, list);
+    NumaNode node{static_cast<std::uint32_t>(std::stoul(name.substr(4))), {}};
+    for (const auto cpu : parse_cpu_list(list)) {
+      if (std::binary_search(allowed.begin(), allowed.end(), cpu)) {
+        node.cpus.push_back(cpu);
+      }
+    }
+    if (!node.cpus.empty()) {
+      nodes.push_back(std::move(node));
+    }
+  }
+  std::sort(nodes.begin(), nodes.end(), [](const NumaNode& a, const NumaNode& b) { return a.id < b.id; });
+#endif
+  if (nodes.empty()) {
+    nodes.push_back({0, allowed});
+  }
+  return nodes;
+}
+
+std::vector<std::uint32_t> CpuTopology::parse_cpu_list(const std::string& list)
+{
+  std::vector<std::uint32_t> cpus;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    std::uint32_t first = 0;
+    std::uint32_t last = 0;
+    char dash = 0;
+    std::stringstream range(item);
+    if (!(range >> first)) {
+      continue;
+    }
+    if (range >> dash) {
+      if (dash != '-' || !(range >> last) || last < first) {
+        continue;
+      }
+    } else {
+      last = first;
+    }
+    for (auto cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+bool CpuTopology::set_affinity([[maybe_unused]] std::thread& thread, [[maybe_unused]] std::span<const std::uint32_t> cpus)
+{
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (const auto cpu : cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &set);
+    }
+  }
+  return CPU_COUNT(&set) != 0 && pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#else
+  return false;
+#endif
+}
+
+std::optional<std::uint32_t> CpuTopology::current_cpu()
+{
+#ifdef __linux__
+  const auto cpu = sched_getcpu();
+  if (cpu >= 0) {
+    return static_cast<std::uint32_t>(cpu);
+  }
+#endif
+  return std::nullopt;
+}
+}  // namespace core
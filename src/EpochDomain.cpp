@@ -0,0 +1,162 @@
+#include "EpochDomain.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+namespace core {
+
+/**
+ * @brief Read section state of the current thread.
+ */
+struct ThreadRecord {
+  ~ThreadRecord()
+  {
+    if (record) {
+      record->epoch.store(0, std::memory_order_release);
+      record->in_use.store(false, std::memory_order_release);
+    }
+  }
+
+  EpochDomain::Record* record = nullptr;
+  std::uint32_t nesting = 0;
+};
+
+namespace {
+thread_local ThreadRecord thread_record;
+
+/**
+ * @brief Scope stored for read sections which may read any data.
+ */
+const char any_scope = 0;
+}  // namespace
+
+EpochDomain::Guard::Guard(const void* scope) { EpochDomain::instance().enter(scope); }
+
+EpochDomain::Guard::~Guard() { EpochDomain::instance().leave(); }
+
+EpochDomain::EpochDomain() : _epoch(1), _records(nullptr) {}
+
+EpochDomain& EpochDomain::instance()
+{
+  static auto* domain = new EpochDomain();
+  return *domain;
+}
+
+bool EpochDomain::Record::holds(const void* scope) const
+{
+  if (!scope) {
+    return true;
+  }
+  for (const auto& entry : scopes) {
+    const auto* held = entry.load(std::memory_order_seq_cst);
+    if (held == scope || held == &any_scope) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void EpochDomain::enter(const void* scope)
+{
+  auto& state = thread_record;
+  if (!state.record) {
+    state.record = acquire_record();
+  }
+  const auto depth = state.nesting++;
+  // The deepest kept level matches any scope if the sections are nested deeper.
+  const auto level = std::min(depth, Record::max_scopes - 1);
+  state.record->scopes[level].store(scope && depth < Record::max_scopes - 1 ? scope : &any_scope,
+                                    std::memory_order_relaxed);
+  if (depth == 0) {
+    // Writers which see the epoch also see the scope.
+    state.record->epoch.store(_epoch.load(std::memory_order_relaxed), std::memory_order_release);
+  }
+  // Pairs with seq_cst operations of writers: either the writer sees this read section and its scope,
+  // or this thread sees the replaced data.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+void EpochDomain::leave()
+{
+  auto& state = thread_record;
+  const auto depth = --state.nesting;
+  if (depth < Record::max_scopes) {
+    state.record->scopes[depth].store(nullptr, std::memory_order_release);
+  }
+  if (depth == 0) {
+    state.record->epoch.store(0, std::memory_order_release);
+  }
+}
+
+void EpochDomain::retire(void* ptr, void (*deleter)(void*))
+{
+  const auto epoch = _epoch.fetch_add(1, std::memory_order_seq_cst);
+  {
+    const std::lock_guard lock(_retired_mutex);
+    _retired.push_back({ptr, deleter, epoch});
+  }
+  reclaim();
+}
+
+void EpochDomain::synchronize(const void* scope)
+{
+  if (thread_record.nesting != 0) {
+    return;
+  }
+  const auto epoch = _epoch.fetch_add(1, std::memory_order_seq_cst);
+  for (auto* record = _records.load(std::memory_order_acquire); record; record = record->next) {
+    for (auto active = record->epoch.load(std::memory_order_seq_cst);
+         active != 0 && active <= epoch && record->holds(scope); active = record->epoch.load(std::memory_order_seq_cst)) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void EpochDomain::reclaim()
+{
+  std::vector<Retired> ready;
+  {
+    const std::lock_guard lock(_retired_mutex);
+    if (_retired.empty()) {
+      return;
+    }
+    const auto min_epoch = min_active_epoch();
+    const auto it = std::partition(_retired.begin(), _retired.end(),
+                                   [min_epoch](const Retired& retired) { return retired.epoch >= min_epoch; });
+    ready.assign(it, _retired.end());
+    _retired.erase(it, _retired.end());
+  }
+  for (const auto& retired : ready) {
+    retired.deleter(retired.ptr);
+  }
+}
+
+EpochDomain::Record* EpochDomain::acquire_record()
+{
+  for (auto* record = _records.load(std::memory_order_acquire); record; record = record->next) {
+    bool in_use = false;
+    if (!record->in_use.load(std::memory_order_relaxed) &&
+        record->in_use.compare_exchange_strong(in_use, true, std::memory_order_acquire)) {
+      return record;
+    }
+  }
+  auto* record = new Record();
+  record->next = _records.load(std::memory_order_relaxed);
+  while (!_records.compare_exchange_weak(record->next, record, std::memory_order_release)) {
+  }
+  return record;
+}
+
+std::uint64_t EpochDomain::min_active_epoch() const
+{
+  auto min_epoch = std::numeric_limits<std::uint64_t>::max();
+  for (auto* record = _records.load(std::memory_order_acquire); record; record = record->next) {
+    const auto epoch = record->epoch.load(std::memory_order_seq_cst);
+    if (epoch != 0) {
+      min_epoch = std::min(min_epoch, epoch);
+    }
+  }
+  return min_epoch;
+}
+}  // namespace core
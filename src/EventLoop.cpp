@@ -0,0 +1,76 @@
+#include "EventLoop.hpp"
+
+#include <iterator>
+#include <utility>
+
+namespace core {
+
+EventLoop::EventLoop() : _stopped(false) {}
+
+EventLoop::SharedPtr EventLoop::current()
+{
+  thread_local const auto loop = std::make_shared<EventLoop>();
+  return loop;
+}
+
+void EventLoop::post(TaskFunction&& func)
+{
+  {
+    const std::lock_guard lock(_mutex);
+    _inbox.push_back(std::move(func));
+  }
+  _cv.notify_one();
+}
+
+std::size_t EventLoop::run_once()
+{
+  std::deque<TaskFunction> messages;
+  {
+    const std::lock_guard lock(_mutex);
+    messages.swap(_inbox);
+  }
+  std::size_t executed = 0;
+  try {
+    for (; !messages.empty(); ++executed) {
+      auto func = std::move(messages.front());
+      messages.pop_front();
+      func();
+    }
+  } catch (...) {
+    const std::lock_guard lock(_mutex);
+    _inbox.insert(_inbox.begin(), std::make_move_iterator(messages.begin()), std::make_move_iterator(messages.end()));
+    throw;
+  }
+  return executed;
+}
+
+void EventLoop::run()
+{
+  for (;;) {
+    {
+      std::unique_lock lock(_mutex);
+      _cv.wait(lock, [this] { return _stopped || !_inbox.empty(); });
+      if (_stopped) {
+        _stopped = false;
+        return;
+      }
+    }
+    run_once();
+  }
+}
+
+void EventLoop::stop()
+{
+  {
+    const std::lock_guard lock(_mutex);
+    _stopped = true;
+  }
+  _cv.notify_all();
+}
+
+std::size_t EventLoop::size() const
+{
+  const std::lock_guard lock(_mutex);
+  return _inbox.size();
+}
+}  // namespace core
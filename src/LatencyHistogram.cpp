@@ -0,0 +1,106 @@
+#include "LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace core {
+
+LatencyHistogram::Snapshot::Snapshot() : _counts{}, _count(0), _sum(0), _max(0) {}
+
+LatencyHistogram::Snapshot& LatencyHistogram::Snapshot::merge(const Snapshot& other)
+{
+  for (std::size_t i = 0; i < bucket_count; ++i) {
+    _counts[i] += other._counts[i];
+  }
+  _count += other._count;
+  _sum += other._sum;
+  _max = std::max(_max, other._max);
+  return *this;
+}
+
+std::uint64_t LatencyHistogram::Snapshot::count() const { return _count; }
+
+std::chrono::nanoseconds LatencyHistogram::Snapshot::max() const
+{
+  return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(_max));
+}
+
+std::chrono::nanoseconds LatencyHistogram::Snapshot::mean() const
+{
+  return std::chrono::nanoseconds(_count ? static_cast<std::chrono::nanoseconds::rep>(_sum / _count) : 0);
+}
+
+std::chrono::nanoseconds LatencyHistogram::Snapshot::percentile(double percentile) const
+{
+  // Bucket counters and the total are updated separately, the total of a snapshot taken during
+  // recording may differ from the sum of buckets.
+  std::uint64_t total = 0;
+  for (const auto count : _counts) {
+    total += count;
+  }
+  if (total == 0) {
+    return std::chrono::nanoseconds(0);
+  }
+  const auto rank = std::max<std::uint64_t>(
+    1, static_cast<std::uint64_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(total))));
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i < bucket_count; ++i) {
+    seen += _counts[i];
+    if (seen >= rank) {
+      return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(std::min(highest_of(i), _max)));
+    }
+  }
+  return max();
+}
+
+std::uint64_t LatencyHistogram::Snapshot::bucket(std::size_t bucket) const { return _counts[bucket]; }
+
+LatencyHistogram::LatencyHistogram() : _counts{}, _count(0), _sum(0), _max(0) {}
+
+void LatencyHistogram::record(std::chrono::nanoseconds value)
+{
+  const auto ns = value.count() > 0 ? static_cast<std::uint64_t>(value.count()) : 0;
+  add(_counts[bucket_of(ns)], 1);
+  add(_count, 1);
+  add(_sum, ns);
+  if (ns > _max.load(std::memory_order_relaxed)) {
+    _max.store(ns, std::memory_order_relaxed);
+  }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const
+{
+  Snapshot snapshot;
+  for (std::size_t i = 0; i < bucket_count; ++i) {
+    snapshot._counts[i] = _counts[i].load(std::memory_order_relaxed);
+  }
+  snapshot._count = _count.load(std::memory_order_relaxed);
+  snapshot._sum = _sum.load(std::memory_order_relaxed);
+  snapshot._max = _max.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+std::size_t LatencyHistogram::bucket_of(std::uint64_t value)
+{
+  if (value < sub_bucket_count) {
+    return static_cast<std::size_t>(value);
+  }
+  // The highest bit selects the power of two range, the next sub_bucket_bits bits select the bucket inside it.
+  const auto shift = static_cast<unsigned>(std::bit_width(value)) - 1 - sub_bucket_bits;
+  return (shift + 1) * sub_bucket_count + static_cast<std::size_t>((value >> shift) & (sub_bucket_count - 1));
+}
+
+std::uint64_t LatencyHistogram::highest_of(std::size_t bucket)
+{
+  if (bucket < sub_bucket_count) {
+    return bucket;
+  }
+  const auto shift = static_cast<unsigned>(bucket / sub_bucket_count - 1);
+  const auto lowest = (sub_bucket_count + bucket % sub_bucket_count) << shift;
+  const auto width = std::uint64_t{1} << shift;
+  return lowest > std::numeric_limits<std::uint64_t>::max() - (width - 1) ? std::numeric_limits<std::uint64_t>::max()
+                                                                         : lowest + width - 1;
+}
+}  // namespace core
@@ -0,0 +1,63 @@
+#include "Subscription.hpp"
+
+#include <utility>
+
+namespace core {
+
+Subscription::Subscription() noexcept : slot_(0), generation_(0) {}
+
+Subscription::Subscription(std::weak_ptr<SubscriptionSource> source, std::uint32_t slot,
+                           std::uint32_t generation) noexcept
+  : source_(std::move(source)), slot_(slot), generation_(generation)
+{
+}
+
+Subscription::Subscription(Subscription&& other) noexcept
+  : source_(std::move(other.source_)), slot_(other.slot_), generation_(other.generation_)
+{
+  other.release();
+}
+
+Subscription& Subscription::operator=(Subscription&& other) noexcept
+{
+  if (this != &other) {
+    reset();
+    source_ = std::move(other.source_);
+    slot_ = other.slot_;
+    generation_ = other.generation_;
+    other.release();
+  }
+  return *this;
+}
+
+Subscription::~Subscription() { reset(); }
+
+void Subscription::disconnect()
+{
+  const auto source = source_.lock();
+  const auto slot = slot_;
+  const auto generation = generation_;
+  release();
+  if (source) {
+    source->Disconnect(slot, generation);
+  }
+}
+
+void Subscription::release() noexcept
+{
+  source_.reset();
+  slot_ = 0;
+  generation_ = 0;
+}
+
+bool Subscription::connected() const noexcept { return !source_.expired(); }
+
+void Subscription::reset() noexcept
+{
+  try {
+    disconnect();
+  } catch (...) {
+    // The subscription is removed even if a handler throws from OnUnsubscribed(), the error can not be reported here.
+  }
+}
+}  // namespace core
@@ -2,7 +2,36 @@
 
 namespace core {
 
-Task::Task(TaskPriority priority) : _priority(priority), _curr_thread_id(std::this_thread::get_id()) {}
+Task::Task(TaskPriority priority, ExecutionPolicy policy)
+  : _priority(priority), _policy(policy), _rescheduled(false), _droppable(true), _deadline(no_deadline),
+    _curr_thread_id(std::this_thread::get_id())
+{
+}
 
-bool Task::empty() const { return _func == nullptr; }
+bool Task::empty() const { return !_func; }
+
+TaskPriority Task::priority() const { return _priority; }
+
+void Task::set_deadline(Clock::time_point deadline) { _deadline = deadline; }
+
+Task::Clock::time_point Task::deadline() const { return _deadline; }
+
+bool Task::is_expired() const { return _deadline != no_deadline && Clock::now() >= _deadline; }
+
+void Task::set_droppable(bool droppable) { _droppable = droppable; }
+
+bool Task::is_droppable() const { return _droppable; }
+
+ExecutionPolicy Task::execution_policy() const { return _policy; }
+
+bool Task::is_reentrant() const { return _curr_thread_id == std::this_thread::get_id(); }
+
+bool Task::mark_rescheduled()
+{
+  if (_policy != ExecutionPolicy::Reschedule || _rescheduled) {
+    return false;
+  }
+  _rescheduled = true;
+  return true;
+}
 }  // namespace evo::foundation
@@ -0,0 +1,83 @@
+#include "TaskDeadlineHeap.hpp"
+
+#include <algorithm>
+
+namespace core {
+
+TaskDeadlineHeap::TaskDeadlineHeap() : _counts{}, _sequence(0) {}
+
+void TaskDeadlineHeap::push_back(Task&& task)
+{
+  _counts[static_cast<std::size_t>(task.priority())]++;
+  _heap.push_back(Entry{std::move(task), _sequence++});
+  std::push_heap(_heap.begin(), _heap.end(), later);
+}
+
+bool TaskDeadlineHeap::pop_front(Task& task)
+{
+  if (_heap.empty()) {
+    return false;
+  }
+  std::pop_heap(_heap.begin(), _heap.end(), later);
+  task = std::move(_heap.back().task);
+  _heap.pop_back();
+  _counts[static_cast<std::size_t>(task.priority())]--;
+  return true;
+}
+
+bool TaskDeadlineHeap::pop_front_lowest(Task& task)
+{
+  return pop_front_lowest(task, TaskPriority::Highest);
+}
+
+bool TaskDeadlineHeap::pop_front_lowest(Task& task, TaskPriority max_priority)
+{
+  if (_heap.empty()) {
+    return false;
+  }
+  const auto lowest = std::min_element(_heap.begin(), _heap.end(), [](const Entry& e1, const Entry& e2) {
+    return e1.task.priority() != e2.task.priority() ? e1.task.priority() < e2.task.priority()
+                                                    : e1.sequence < e2.sequence;
+  });
+  if (lowest->task.priority() > max_priority) {
+    return false;
+  }
+  take(static_cast<std::size_t>(lowest - _heap.begin()), task);
+  return true;
+}
+
+bool TaskDeadlineHeap::has_lower_lanes() const
+{
+  return std::count_if(_counts.begin(), _counts.end(), [](std::size_t count) { return count != 0; }) > 1;
+}
+
+bool TaskDeadlineHeap::empty() const { return _heap.empty(); }
+
+void TaskDeadlineHeap::clear()
+{
+  _heap.clear();
+  _counts.fill(0);
+}
+
+bool TaskDeadlineHeap::later(const Entry& e1, const Entry& e2)
+{
+  if (e1.task.deadline() != e2.task.deadline()) {
+    return e1.task.deadline() > e2.task.deadline();
+  }
+  if (e1.task.priority() != e2.task.priority()) {
+    return e1.task.priority() < e2.task.priority();
+  }
+  return e1.sequence > e2.sequence;
+}
+
+void TaskDeadlineHeap::take(std::size_t index, Task& task)
+{
+  task = std::move(_heap[index].task);
+  _counts[static_cast<std::size_t>(task.priority())]--;
+  if (index != _heap.size() - 1) {
+    _heap[index] = std::move(_heap.back());
+  }
+  _heap.pop_back();
+  std::make_heap(_heap.begin(), _heap.end(), later);
+}
+}  // namespace core
@@ -0,0 +1,152 @@
+#include "TaskGraph.hpp"
+
+#include <stdexcept>
+
+namespace core {
+
+TaskGraph::TaskGraph() : _pool(nullptr), _remaining(0), _failed(false), _running(false), _validated(true) {}
+
+TaskGraph::~TaskGraph()
+{
+  std::unique_lock lock(_done_mutex);
+  _done_cv.wait(lock, [this] { return !_running; });
+}
+
+void TaskGraph::add_edge(NodeId from, NodeId to)
+{
+  if (from >= _nodes.size() || to >= _nodes.size()) {
+    throw std::out_of_range("TaskGraph node id is out of range");
+  }
+  if (from == to) {
+    throw std::invalid_argument("TaskGraph node can not precede itself");
+  }
+  _nodes[from].successors.push_back(to);
+  ++_nodes[to].predecessors;
+  _validated = false;
+}
+
+std::size_t TaskGraph::size() const { return _nodes.size(); }
+
+void TaskGraph::run(ThreadPool& pool)
+{
+  {
+    const std::lock_guard lock(_done_mutex);
+    if (_running) {
+      throw std::logic_error("TaskGraph is already running");
+    }
+    if (!_validated) {
+      validate();
+    }
+    if (_nodes.empty()) {
+      return;
+    }
+    _running = true;
+  }
+
+  _pool = &pool;
+  _failed.store(false, std::memory_order_relaxed);
+  _error = nullptr;
+  _remaining.store(_nodes.size(), std::memory_order_relaxed);
+  for (auto& node : _nodes) {
+    node.pending.store(node.predecessors, std::memory_order_relaxed);
+  }
+  for (const auto root : _roots) {
+    schedule(root);
+  }
+}
+
+void TaskGraph::wait()
+{
+  {
+    std::unique_lock lock(_done_mutex);
+    _done_cv.wait(lock, [this] { return !_running; });
+  }
+  if (_error) {
+    std::rethrow_exception(_error);
+  }
+}
+
+void TaskGraph::validate()
+{
+  _roots.clear();
+  std::vector<std::size_t> pending(_nodes.size());
+  std::vector<NodeId> ready;
+  for (NodeId id = 0; id < _nodes.size(); ++id) {
+    pending[id] = _nodes[id].predecessors;
+    if (pending[id] == 0) {
+      _roots.push_back(id);
+      ready.push_back(id);
+    }
+  }
+
+  std::size_t visited = 0;
+  while (!ready.empty()) {
+    const auto id = ready.back();
+    ready.pop_back();
+    ++visited;
+    for (const auto successor : _nodes[id].successors) {
+      if (--pending[successor] == 0) {
+        ready.push_back(successor);
+      }
+    }
+  }
+  if (visited != _nodes.size()) {
+    _roots.clear();
+    throw std::logic_error("TaskGraph contains a cycle");
+  }
+  _validated = true;
+}
+
+void TaskGraph::schedule(NodeId id)
+{
+  Task task(_nodes[id].priority);
+  task.set_droppable(false);
+  task.assign_detached([this, id] { execute(id); });
+  if (!_pool->try_push_task(task)) {
+    execute(id);
+  }
+}
+
+void TaskGraph::execute(NodeId id)
+{
+  while (true) {
+    auto& node = _nodes[id];
+    if (!_failed.load(std::memory_order_relaxed)) {
+      try {
+        node.func();
+      } catch (...) {
+        const std::lock_guard lock(_error_mutex);
+        if (!_error) {
+          _error = std::current_exception();
+        }
+        _failed.store(true, std::memory_order_relaxed);
+      }
+    }
+
+    // Successors are released before the node is counted as finished, so the graph
+    // can not be finished (and destroyed) while this thread still uses it.
+    bool has_next = false;
+    NodeId next = 0;
+    for (const auto successor : node.successors) {
+      if (_nodes[successor].pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        if (has_next) {
+          schedule(next);
+        }
+        next = successor;
+        has_next = true;
+      }
+    }
+
+    if (_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      const std::lock_guard lock(_done_mutex);
+      _running = false;
+      _done_cv.notify_all();
+      return;
+    }
+    if (!has_next) {
+      return;
+    }
+    id = next;
+  }
+}
+}  // namespace core
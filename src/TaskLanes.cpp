@@ -0,0 +1,81 @@
+#include "TaskLanes.hpp"
+
+#include <bit>
+
+namespace core {
+
+TaskLanes::TaskLanes() : _mask(0) {}
+
+void TaskLanes::push_back(Task&& task)
+{
+  const auto lane = static_cast<std::size_t>(task.priority());
+  _lanes[lane].push_back(std::move(task));
+  _mask |= 1u << lane;
+}
+
+bool TaskLanes::pop_front(Task& task)
+{
+  if (_mask == 0) {
+    return false;
+  }
+  take_front(highest_lane(), task);
+  return true;
+}
+
+bool TaskLanes::pop_back(Task& task)
+{
+  if (_mask == 0) {
+    return false;
+  }
+  const auto lane = highest_lane();
+  task = std::move(_lanes[lane].back());
+  _lanes[lane].pop_back();
+  if (_lanes[lane].empty()) {
+    _mask &= ~(1u << lane);
+  }
+  return true;
+}
+
+bool TaskLanes::pop_front_lowest(Task& task)
+{
+  if (_mask == 0) {
+    return false;
+  }
+  take_front(lowest_lane(), task);
+  return true;
+}
+
+bool TaskLanes::pop_front_lowest(Task& task, TaskPriority max_priority)
+{
+  if (_mask == 0 || lowest_lane() > static_cast<std::size_t>(max_priority)) {
+    return false;
+  }
+  take_front(lowest_lane(), task);
+  return true;
+}
+
+bool TaskLanes::has_lower_lanes() const { return std::popcount(_mask) > 1; }
+
+bool TaskLanes::empty() const { return _mask == 0; }
+
+void TaskLanes::clear()
+{
+  for (auto& lane : _lanes) {
+    lane.clear();
+  }
+  _mask = 0;
+}
+
+std::size_t TaskLanes::highest_lane() const { return std::bit_width(_mask) - 1; }
+
+std::size_t TaskLanes::lowest_lane() const { return std::countr_zero(_mask); }
+
+void TaskLanes::take_front(std::size_t lane, Task& task)
+{
+  task = std::move(_lanes[lane].front());
+  _lanes[lane].pop_front();
+  if (_lanes[lane].empty()) {
+    _mask &= ~(1u << lane);
+  }
+}
+}  // namespace core
@@ -1,43 +1,178 @@
 #include "TaskQueue.hpp"
 
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
 namespace core {
 
-TaskQueue::TaskQueue(std::uint32_t max_queue_size)
-  : _queue_size(0), _is_released(false), _max_queue_size(max_queue_size)
+TaskQueue::TaskQueue(std::uint32_t max_queue_size, TaskQueueType type)
+  : _queue_size(0), _is_released(false), _max_queue_size(max_queue_size), _type(type), _waiters(0), _wake_epoch(0)
+  , _starvation_limit(0), _bypass_count(0)
 {
+  if (_type == TaskQueueType::LockFree) {
+    if (_max_queue_size == 0) {
+      throw std::invalid_argument("Lock-free task queue requires max queue size greater than 0!");
+    }
+    _ring = std::make_unique<TaskRing>(_max_queue_size, task_priority_count);
+  }
 }
 
-bool TaskQueue::push(const Task& task)
+bool TaskQueue::push(Task&& task)
 {
+  if (_type == TaskQueueType::LockFree) {
+    return push_lock_free(std::move(task));
+  }
   if (_max_queue_size == 0 || _queue_size.load(std::memory_order_acquire) < _max_queue_size) {
     const std::lock_guard lock(_mutex);
-    _task_queue.push(task);
+    visit_locked([&task](auto& queue) { queue.push_back(std::move(task)); });
     _queue_size.fetch_add(1, std::memory_order_release);
-    _cv.notify_one();
+    if (_waiters.load(std::memory_order_relaxed) != 0) {
+      _cv.notify_one();
+    }
     return true;
   } else {
     return false;
   }
 }
 
+std::size_t TaskQueue::push_bulk(std::span<Task> tasks)
+{
+  if (tasks.empty()) {
+    return 0;
+  }
+  if (_type == TaskQueueType::LockFree) {
+    const auto count = reserve(static_cast<std::uint32_t>(std::min<std::size_t>(tasks.size(), std::numeric_limits<std::uint32_t>::max())));
+    for (std::uint32_t i = 0; i < count; ++i) {
+      const auto lane = static_cast<std::size_t>(tasks[i].priority());
+      while (!_ring->try_push(std::move(tasks[i]), lane)) {
+        std::this_thread::yield();
+      }
+    }
+    if (count != 0) {
+      wake_waiters(count);
+    }
+    return count;
+  }
+
+  const std::lock_guard lock(_mutex);
+  std::size_t count = tasks.size();
+  if (_max_queue_size != 0) {
+    const auto size = _queue_size.load(std::memory_order_relaxed);
+    count = size < _max_queue_size ? std::min<std::size_t>(count, _max_queue_size - size) : 0;
+  }
+  visit_locked([tasks, count](auto& queue) {
+    for (std::size_t i = 0; i < count; ++i) {
+      queue.push_back(std::move(tasks[i]));
+    }
+  });
+  _queue_size.fetch_add(static_cast<std::uint32_t>(count), std::memory_order_release);
+  const auto waiters = _waiters.load(std::memory_order_relaxed);
+  if (count >= waiters) {
+    _cv.notify_all();
+  } else {
+    for (std::size_t i = 0; i < count; ++i) {
+      _cv.notify_one();
+    }
+  }
+  return count;
+}
+
+bool TaskQueue::replace_lowest(Task&& task, Task& evicted)
+{
+  if (_type == TaskQueueType::LockFree) {
+    const auto max_lane = static_cast<std::size_t>(task.priority());
+    for (std::size_t lane = 0; lane <= max_lane; ++lane) {
+      if (_ring->try_pop(evicted, lane)) {
+        // The place of the evicted task stays reserved for the new one.
+        while (!_ring->try_push(std::move(task), max_lane)) {
+          std::this_thread::yield();
+        }
+        wake_waiters(1);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  const std::lock_guard lock(_mutex);
+  const bool replaced = visit_locked([&task, &evicted](auto& queue) {
+    if (!queue.pop_front_lowest(evicted, task.priority())) {
+      return false;
+    }
+    queue.push_back(std::move(task));
+    return true;
+  });
+  if (!replaced) {
+    return false;
+  }
+  if (_waiters.load(std::memory_order_relaxed) != 0) {
+    _cv.notify_one();
+  }
+  return true;
+}
+
 Task TaskQueue::pop()
 {
+  if (_type == TaskQueueType::LockFree) {
+    Task task;
+    while (!try_pop_lock_free(task) && !_is_released.load(std::memory_order_acquire)) {
+      _waiters.fetch_add(1, std::memory_order_seq_cst);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const auto epoch = _wake_epoch.load(std::memory_order_seq_cst);
+      if (try_pop_lock_free(task)) {
+        _waiters.fetch_sub(1, std::memory_order_release);
+        break;
+      }
+      if (!_is_released.load(std::memory_order_acquire)) {
+        _wake_epoch.wait(epoch, std::memory_order_acquire);
+      }
+      _waiters.fetch_sub(1, std::memory_order_release);
+    }
+    return task;
+  }
+
   std::unique_lock lock(_mutex);
-  _cv.wait(lock, [this] {
+  const auto is_ready = [this] {
     return _queue_size.load(std::memory_order_acquire) || _is_released.load(std::memory_order_acquire);
-  });
+  };
+  if (!is_ready()) {
+    _waiters.fetch_add(1, std::memory_order_relaxed);
+    _cv.wait(lock, is_ready);
+    _waiters.fetch_sub(1, std::memory_order_relaxed);
+  }
   Task task;
   if (_queue_size.load(std::memory_order_acquire)) {
-    task = std::move(_task_queue.top());
-    _task_queue.pop();
-    _queue_size.fetch_sub(1, std::memory_order_release);
+    take_task(task);
   }
   return task;
 }
 
+bool TaskQueue::try_pop(Task& task)
+{
+  if (_type == TaskQueueType::LockFree) {
+    return try_pop_lock_free(task);
+  }
+  if (_queue_size.load(std::memory_order_acquire) == 0) {
+    return false;
+  }
+  const std::lock_guard lock(_mutex);
+  if (visit_locked([](const auto& queue) { return queue.empty(); })) {
+    return false;
+  }
+  take_task(task);
+  return true;
+}
+
 void TaskQueue::release()
 {
   _is_released.store(true, std::memory_order_release);
+  if (_type == TaskQueueType::LockFree) {
+    _wake_epoch.fetch_add(1, std::memory_order_seq_cst);
+    _wake_epoch.notify_all();
+    return;
+  }
   _cv.notify_all();
 }
 void TaskQueue::acquire() { _is_released.store(false, std::memory_order_release); }
@@ -47,9 +182,118 @@ bool TaskQueue::empty() const { return _queue_size.load(std::memory_order_acquir
 
 void TaskQueue::clear()
 {
+  if (_type == TaskQueueType::LockFree) {
+    Task task;
+    while (try_pop_lock_free(task)) {
+    }
+    return;
+  }
   const std::lock_guard lock(_mutex);
-  decltype(_task_queue) empty;
-  std::swap(_task_queue, empty);
+  visit_locked([](auto& queue) { queue.clear(); });
   _queue_size.store(0, std::memory_order_release);
 }
+
+TaskQueueType TaskQueue::type() const { return _type; }
+
+void TaskQueue::set_starvation_limit(std::uint32_t limit)
+{
+  _starvation_limit.store(limit, std::memory_order_relaxed);
+  _bypass_count.store(0, std::memory_order_relaxed);
+}
+
+std::uint32_t TaskQueue::starvation_limit() const { return _starvation_limit.load(std::memory_order_relaxed); }
+
+void TaskQueue::take_task(Task& task)
+{
+  const auto limit = _starvation_limit.load(std::memory_order_relaxed);
+  visit_locked([this, &task, limit](auto& queue) {
+    if (limit != 0 && queue.has_lower_lanes()) {
+      if (_bypass_count.fetch_add(1, std::memory_order_relaxed) >= limit) {
+        _bypass_count.store(0, std::memory_order_relaxed);
+        queue.pop_front_lowest(task);
+        return;
+      }
+    } else {
+      _bypass_count.store(0, std::memory_order_relaxed);
+    }
+    queue.pop_front(task);
+  });
+  _queue_size.fetch_sub(1, std::memory_order_release);
+}
+
+bool TaskQueue::push_lock_free(Task&& task)
+{
+  if (reserve(1) == 0) {
+    return false;
+  }
+  const auto lane = static_cast<std::size_t>(task.priority());
+  // The ring may look full only while a consumer returns the slot of the extracted task.
+  while (!_ring->try_push(std::move(task), lane)) {
+    std::this_thread::yield();
+  }
+  wake_waiters(1);
+  return true;
+}
+
+std::uint32_t TaskQueue::reserve(std::uint32_t count)
+{
+  // Places are reserved before insertion, so rings never hold more than max queue size tasks.
+  auto size = _queue_size.load(std::memory_order_relaxed);
+  std::uint32_t reserved = 0;
+  do {
+    if (size >= _max_queue_size) {
+      return 0;
+    }
+    reserved = std::min(count, _max_queue_size - size);
+  } while (!_queue_size.compare_exchange_weak(size, size + reserved, std::memory_order_acq_rel));
+  return reserved;
+}
+
+bool TaskQueue::try_pop_lock_free(Task& task)
+{
+  if (_queue_size.load(std::memory_order_acquire) == 0) {
+    return false;
+  }
+  const auto limit = _starvation_limit.load(std::memory_order_relaxed);
+  if (limit != 0 && _bypass_count.load(std::memory_order_relaxed) >= limit) {
+    _bypass_count.store(0, std::memory_order_relaxed);
+    for (std::size_t lane = 0; lane < task_priority_count; ++lane) {
+      if (_ring->try_pop(task, lane)) {
+        _queue_size.fetch_sub(1, std::memory_order_release);
+        return true;
+      }
+    }
+    return false;
+  }
+  for (auto lane = task_priority_count; lane-- != 0;) {
+    if (_ring->try_pop(task, lane)) {
+      _queue_size.fetch_sub(1, std::memory_order_release);
+      if (limit != 0 && lane != 0) {
+        // Lower rings are not tracked, every extraction above the lowest level is counted.
+        _bypass_count.fetch_add(1, std::memory_order_relaxed);
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+void TaskQueue::wake_waiters(std::size_t count)
+{
+  // Pairs with the waiter registration in pop(): either the waiter sees the new task,
+  // or this thread sees the waiter.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const auto waiters = _waiters.load(std::memory_order_relaxed);
+  if (waiters == 0) {
+    return;
+  }
+  _wake_epoch.fetch_add(1, std::memory_order_seq_cst);
+  if (count >= waiters) {
+    _wake_epoch.notify_all();
+  } else {
+    for (std::size_t i = 0; i < count; ++i) {
+      _wake_epoch.notify_one();
+    }
+  }
+}
 }  // namespace core
@@ -0,0 +1,122 @@
+#include "TaskRing.hpp"
+
+#include <bit>
+#include <stdexcept>
+#include <thread>
+
+namespace core {
+
+namespace {
+std::uint32_t check_capacity(std::uint32_t capacity, std::size_t lane_count)
+{
+  if (capacity == 0 || capacity > TaskRing::max_capacity || lane_count == 0) {
+    throw std::invalid_argument("Task ring requires capacity in range [1, 2^30] and at least one lane!");
+  }
+  return capacity;
+}
+}  // namespace
+
+TaskRing::TaskRing(std::uint32_t capacity, std::size_t lane_count)
+  : _capacity(check_capacity(capacity, lane_count))
+  , _lane_count(lane_count)
+  , _lanes(new IndexRing[lane_count])
+{
+  _tasks.reset(new Task[_capacity]);
+  const auto ring_capacity = std::bit_ceil(_capacity);
+  _free.init(ring_capacity);
+  for (std::size_t lane = 0; lane < _lane_count; ++lane) {
+    _lanes[lane].init(ring_capacity);
+  }
+  for (std::uint32_t index = 0; index < _capacity; ++index) {
+    _free.try_push(index);
+  }
+}
+
+bool TaskRing::try_push(Task&& task, std::size_t lane)
+{
+  std::uint32_t index;
+  if (!_free.try_pop(index)) {
+    return false;
+  }
+  _tasks[index] = std::move(task);
+  // Index rings have room for every slot, push fails only while a consumer of the previous lap finishes extraction.
+  while (!_lanes[lane].try_push(index)) {
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+bool TaskRing::try_pop(Task& task, std::size_t lane)
+{
+  std::uint32_t index;
+  if (!_lanes[lane].try_pop(index)) {
+    return false;
+  }
+  task = std::move(_tasks[index]);
+  while (!_free.try_push(index)) {
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+std::size_t TaskRing::capacity() const { return _capacity; }
+
+std::size_t TaskRing::lane_count() const { return _lane_count; }
+
+std::size_t TaskRing::footprint(std::uint32_t capacity, std::size_t lane_count)
+{
+  return sizeof(TaskRing) + capacity * sizeof(Task) +
+         (lane_count + 1) * (sizeof(IndexRing) + std::bit_ceil(capacity) * sizeof(IndexRing::Slot));
+}
+
+void TaskRing::IndexRing::init(std::uint32_t capacity)
+{
+  _slots.reset(new Slot[capacity]);
+  _mask = capacity - 1;
+  for (std::uint32_t i = 0; i < capacity; ++i) {
+    _slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+bool TaskRing::IndexRing::try_push(std::uint32_t index)
+{
+  std::uint32_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+  for (;;) {
+    Slot& slot = _slots[pos & _mask];
+    const std::uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+    const auto diff = static_cast<std::int32_t>(sequence - pos);
+    if (diff == 0) {
+      if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        slot.index = index;
+        slot.sequence.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      return false;
+    } else {
+      pos = _enqueue_pos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool TaskRing::IndexRing::try_pop(std::uint32_t& index)
+{
+  std::uint32_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+  for (;;) {
+    Slot& slot = _slots[pos & _mask];
+    const std::uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+    const auto diff = static_cast<std::int32_t>(sequence - (pos + 1));
+    if (diff == 0) {
+      if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        index = slot.index;
+        slot.sequence.store(pos + _mask + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      return false;
+    } else {
+      pos = _dequeue_pos.load(std::memory_order_relaxed);
+    }
+  }
+}
+}  // namespace core
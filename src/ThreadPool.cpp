@@ -1,22 +1,86 @@
 #include "ThreadPool.hpp"
+#include "TraceRecorder.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
 
 namespace core {
 
-ThreadPool::ThreadPool(std::uint32_t thread_count, std::uint32_t max_task_queue_size)
-  : _tasks(TaskQueue(max_task_queue_size))
+namespace {
+/**
+ * @brief Pool owning the current thread, nullptr for threads created outside of any pool.
+ */
+thread_local const ThreadPool* current_pool = nullptr;
+/**
+ * @brief Index of the current thread in its pool.
+ */
+thread_local std::uint32_t current_index = 0;
+/**
+ * @brief State of the victim selection generator (xorshift32).
+ */
+thread_local std::uint32_t victim_seed = 0;
+
+std::uint32_t next_victim_seed()
+{
+  victim_seed ^= victim_seed << 13;
+  victim_seed ^= victim_seed >> 17;
+  victim_seed ^= victim_seed << 5;
+  return victim_seed;
+}
+}  // namespace
+
+ThreadPool::ThreadPool(std::uint32_t thread_count, std::uint32_t max_task_queue_size, SchedulingPolicy policy,
+                       TaskQueueType queue_type, std::vector<NumaNode> numa_nodes)
+  : _tasks(TaskQueue(max_task_queue_size, queue_type))
+  , _policy(policy)
+  , _max_task_queue_size(max_task_queue_size)
+  , _local_tasks_total(0)
+  , _idle_count(0)
   , _thread_count(thread_count ? thread_count : 1)
   , _threads(new std::thread[_thread_count ? _thread_count : 1])
   , _tasks_total(0)
+  , _reentrant_tasks(0)
+  , _overflow_policy(OverflowPolicy::Reject)
+  , _overflow_timeout(std::chrono::milliseconds(0))
+  , _rejected_tasks(0)
+  , _blocked_pushes(0)
+  , _timed_out_pushes(0)
+  , _caller_runs(0)
+  , _dropped_tasks(0)
+  , _expired_policy(ExpiredTaskPolicy::Run)
+  , _expired_tasks(0)
+  , _space_waiters(0)
   , _paused(false)
   , _joined(false)
+  , _running(true)
 {
+  if (is_work_stealing()) {
+    _local_tasks.reset(new WorkStealingQueue[_thread_count]);
+  }
+  if (_policy == SchedulingPolicy::NumaWorkStealing) {
+    _numa_nodes = numa_nodes.empty() ? CpuTopology::numa_nodes() : std::move(numa_nodes);
+    for (std::uint32_t node = 0; node < _numa_nodes.size(); ++node) {
+      _node_tasks.push_back(std::make_unique<TaskQueue>(max_task_queue_size, queue_type));
+      for (const auto cpu : _numa_nodes[node].cpus) {
+        if (cpu >= _cpu_nodes.size()) {
+          _cpu_nodes.resize(cpu + 1, -1);
+        }
+        if (_cpu_nodes[cpu] < 0) {
+          _cpu_nodes[cpu] = static_cast<std::int32_t>(node);
+        }
+      }
+    }
+  }
   create_threads();
-  _running.store(true, std::memory_order_relaxed);
 }
 
 ThreadPool::~ThreadPool() { join_all(); }
 
-std::uint32_t ThreadPool::get_queued_task_count() const { return _tasks.size(); }
+std::uint32_t ThreadPool::get_queued_task_count() const
+{
+  return _tasks.size() + _local_tasks_total.load(std::memory_order_acquire);
+}
 
 std::uint32_t ThreadPool::get_running_task_count() const
 {
@@ -27,18 +91,352 @@ std::uint32_t ThreadPool::get_total_task_count() const { return _tasks_total; }
 
 std::uint32_t ThreadPool::get_thread_count() const { return _thread_count; }
 
-bool ThreadPool::push_task(const Task& task)
+std::uint64_t ThreadPool::get_reentrant_task_count() const
 {
-  if (!_joined.load(std::memory_order_acquire)) {
-    _tasks_total.fetch_add(1, std::memory_order_release);
-    return _tasks.push(task);
-  } else {
+  return _reentrant_tasks.load(std::memory_order_relaxed);
+}
+
+ThreadPoolMetrics ThreadPool::get_metrics() const
+{
+  ThreadPoolMetrics metrics;
+#ifdef CORE_ENABLE_METRICS
+  metrics.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _metrics_start);
+  metrics.workers.resize(_thread_count);
+  for (std::uint32_t i = 0; i < _thread_count; ++i) {
+    const auto& worker_metrics = _worker_metrics[i];
+    auto& worker = metrics.workers[i];
+    worker.executed = worker_metrics.executed.load(std::memory_order_relaxed);
+    worker.failed = worker_metrics.failed.load(std::memory_order_relaxed);
+    worker.stolen = worker_metrics.stolen.load(std::memory_order_relaxed);
+    worker.busy_time = std::chrono::nanoseconds(worker_metrics.busy_time.load(std::memory_order_relaxed));
+    if (metrics.elapsed.count() > 0) {
+      worker.utilisation = std::min(1.0, static_cast<double>(worker.busy_time.count()) / metrics.elapsed.count());
+    }
+    for (std::size_t priority = 0; priority < task_priority_count; ++priority) {
+      metrics.queue_wait[priority].merge(worker_metrics.queue_wait[priority].snapshot());
+      metrics.execution[priority].merge(worker_metrics.execution[priority].snapshot());
+    }
+  }
+#endif
+  return metrics;
+}
+
+SchedulingPolicy ThreadPool::get_scheduling_policy() const { return _policy; }
+
+const std::vector<NumaNode>& ThreadPool::get_numa_nodes() const { return _numa_nodes; }
+
+std::uint32_t ThreadPool::get_thread_numa_node(std::uint32_t index) const
+{
+  return index < _thread_nodes.size() ? _thread_nodes[index] : 0;
+}
+
+bool ThreadPool::set_cpu_affinity(std::vector<std::uint32_t> cpus)
+{
+  _cpu_affinity = std::move(cpus);
+  bool pinned = true;
+  if (!_cpu_affinity.empty() && _running.load(std::memory_order_acquire)) {
+    for (std::uint32_t i = 0; i < _thread_count; ++i) {
+      if (_threads[i].joinable()) {
+        pinned = CpuTopology::set_affinity(_threads[i], {&_cpu_affinity[i % _cpu_affinity.size()], 1}) && pinned;
+      }
+    }
+  }
+  return pinned;
+}
+
+std::vector<std::uint32_t> ThreadPool::get_cpu_affinity() const { return _cpu_affinity; }
+
+TaskQueueType ThreadPool::get_task_queue_type() const { return _tasks.type(); }
+
+void ThreadPool::set_starvation_limit(std::uint32_t limit)
+{
+  _tasks.set_starvation_limit(limit);
+  for (auto& pQueue : _node_tasks) {
+    pQueue->set_starvation_limit(limit);
+  }
+}
+
+void ThreadPool::set_overflow_policy(OverflowPolicy policy, std::chrono::milliseconds timeout)
+{
+  _overflow_timeout.store(timeout, std::memory_order_relaxed);
+  _overflow_policy.store(policy, std::memory_order_release);
+}
+
+OverflowPolicy ThreadPool::get_overflow_policy() const { return _overflow_policy.load(std::memory_order_acquire); }
+
+OverflowStats ThreadPool::get_overflow_stats() const
+{
+  OverflowStats stats;
+  stats.rejected = _rejected_tasks.load(std::memory_order_relaxed);
+  stats.blocked = _blocked_pushes.load(std::memory_order_relaxed);
+  stats.timed_out = _timed_out_pushes.load(std::memory_order_relaxed);
+  stats.caller_runs = _caller_runs.load(std::memory_order_relaxed);
+  stats.dropped = _dropped_tasks.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void ThreadPool::set_expired_task_policy(ExpiredTaskPolicy policy)
+{
+  _expired_policy.store(policy, std::memory_order_relaxed);
+}
+
+ExpiredTaskPolicy ThreadPool::get_expired_task_policy() const
+{
+  return _expired_policy.load(std::memory_order_relaxed);
+}
+
+std::uint64_t ThreadPool::get_expired_task_count() const { return _expired_tasks.load(std::memory_order_relaxed); }
+
+bool ThreadPool::push_task(Task&& task)
+{
+  if (_joined.load(std::memory_order_acquire)) {
     return false;
   }
+  if (try_push_task(task) || push_overflowed(task, true)) {
+    return true;
+  }
+  _rejected_tasks.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+void ThreadPool::mark_enqueued([[maybe_unused]] std::span<Task> tasks)
+{
+#ifdef CORE_ENABLE_METRICS
+  const auto now = Task::Clock::now();
+  for (auto& task : tasks) {
+    task.mark_enqueued(now);
+  }
+#endif
+#ifdef CORE_ENABLE_TRACING
+  auto& recorder = TraceRecorder::instance();
+  if (recorder.is_enabled()) {
+    const auto timestamp = TraceRecorder::now();
+    for (auto& task : tasks) {
+      task.set_trace_id(recorder.next_flow_id());
+      recorder.record({"push", "task", timestamp, 0, task.trace_id(), TraceFlow::Out});
+    }
+  }
+#endif
+}
+
+bool ThreadPool::try_push_task(Task& task)
+{
+  if (_joined.load(std::memory_order_acquire)) {
+    return false;
+  }
+  mark_enqueued({&task, 1});
+  _tasks_total.fetch_add(1, std::memory_order_release);
+  if (_policy == SchedulingPolicy::SharedQueue) {
+    if (!_tasks.push(std::move(task))) {
+      _tasks_total.fetch_sub(1, std::memory_order_release);
+      return false;
+    }
+    return true;
+  }
+
+  if (current_pool == this) {
+    if (_max_task_queue_size != 0 && get_queued_task_count() >= _max_task_queue_size) {
+      _tasks_total.fetch_sub(1, std::memory_order_release);
+      return false;
+    }
+    _local_tasks_total.fetch_add(1, std::memory_order_release);
+    _local_tasks[current_index].push(std::move(task));
+  } else if (const auto node = current_node(); node >= 0) {
+    if (_max_task_queue_size != 0 && get_queued_task_count() >= _max_task_queue_size) {
+      _tasks_total.fetch_sub(1, std::memory_order_release);
+      return false;
+    }
+    _local_tasks_total.fetch_add(1, std::memory_order_release);
+    if (!_node_tasks[node]->push(std::move(task))) {
+      _local_tasks_total.fetch_sub(1, std::memory_order_release);
+      _tasks_total.fetch_sub(1, std::memory_order_release);
+      return false;
+    }
+  } else if (!_tasks.push(std::move(task))) {
+    _tasks_total.fetch_sub(1, std::memory_order_release);
+    return false;
+  }
+  wake_workers(1);
+  return true;
+}
+
+std::size_t ThreadPool::push_tasks(std::span<Task> tasks)
+{
+  auto count = try_push_tasks(tasks);
+  if (_joined.load(std::memory_order_acquire)) {
+    return count;
+  }
+  while (count < tasks.size()) {
+    if (!push_overflowed(tasks[count], true)) {
+      _rejected_tasks.fetch_add(1, std::memory_order_relaxed);
+      break;
+    }
+    ++count;
+  }
+  return count;
+}
+
+std::size_t ThreadPool::push_tasks_nothrow(std::span<Task> tasks)
+{
+  auto count = try_push_tasks(tasks);
+  // Tasks pushed while join_all() waits, e.g. by running tasks, are executed in place.
+  const bool joined = _joined.load(std::memory_order_acquire);
+  bool rejected = false;
+  for (auto i = count; i < tasks.size(); ++i) {
+    // After the first rejection the policy is not applied again, so Block policy waits once per call.
+    if (!joined && (rejected ? try_push_task(tasks[i]) : push_overflowed(tasks[i], false))) {
+      ++count;
+      continue;
+    }
+    rejected = true;
+    if (joined || !tasks[i].is_droppable()) {
+      _caller_runs.fetch_add(1, std::memory_order_relaxed);
+      run_in_caller(tasks[i]);
+      ++count;
+    } else {
+      _rejected_tasks.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  return count;
+}
+
+std::size_t ThreadPool::try_push_tasks(std::span<Task> tasks)
+{
+  if (tasks.empty() || _joined.load(std::memory_order_acquire)) {
+    return 0;
+  }
+  mark_enqueued(tasks);
+  _tasks_total.fetch_add(static_cast<std::uint32_t>(tasks.size()), std::memory_order_release);
+  std::size_t count = 0;
+  const auto node = is_work_stealing() && current_pool != this ? current_node() : -1;
+  if (is_work_stealing() && (current_pool == this || node >= 0)) {
+    count = tasks.size();
+    if (_max_task_queue_size != 0) {
+      const auto queued = get_queued_task_count();
+      count = queued < _max_task_queue_size ? std::min<std::size_t>(count, _max_task_queue_size - queued) : 0;
+    }
+    _local_tasks_total.fetch_add(static_cast<std::uint32_t>(count), std::memory_order_release);
+    if (current_pool == this) {
+      _local_tasks[current_index].push_bulk(tasks.first(count));
+    } else {
+      const auto pushed = _node_tasks[node]->push_bulk(tasks.first(count));
+      _local_tasks_total.fetch_sub(static_cast<std::uint32_t>(count - pushed), std::memory_order_release);
+      count = pushed;
+    }
+  } else {
+    count = _tasks.push_bulk(tasks);
+  }
+  _tasks_total.fetch_sub(static_cast<std::uint32_t>(tasks.size() - count), std::memory_order_release);
+  if (is_work_stealing() && count != 0) {
+    wake_workers(count);
+  }
+  return count;
+}
+
+bool ThreadPool::push_overflowed(Task& task, bool may_throw)
+{
+  switch (_overflow_policy.load(std::memory_order_acquire)) {
+    case OverflowPolicy::Block:
+      _blocked_pushes.fetch_add(1, std::memory_order_relaxed);
+      if (push_blocking(task)) {
+        return true;
+      }
+      _timed_out_pushes.fetch_add(1, std::memory_order_relaxed);
+      break;
+    case OverflowPolicy::CallerRuns:
+      _caller_runs.fetch_add(1, std::memory_order_relaxed);
+      run_in_caller(task);
+      return true;
+    case OverflowPolicy::DropOldest: {
+      Task evicted;
+      bool replaced = _tasks.replace_lowest(std::move(task), evicted);
+      for (std::size_t node = 0; !replaced && node < _node_tasks.size(); ++node) {
+        replaced = _node_tasks[node]->replace_lowest(std::move(task), evicted);
+      }
+      if (replaced) {
+        if (is_work_stealing()) {
+          wake_workers(1);
+        }
+        // Tasks other code waits for are executed instead of being dropped.
+        if (evicted.is_droppable()) {
+          _dropped_tasks.fetch_add(1, std::memory_order_relaxed);
+        } else {
+          _caller_runs.fetch_add(1, std::memory_order_relaxed);
+          run_in_caller(evicted);
+        }
+        return true;
+      }
+      break;
+    }
+    case OverflowPolicy::Throw:
+      if (may_throw) {
+        _rejected_tasks.fetch_add(1, std::memory_order_relaxed);
+        throw std::overflow_error("Thread pool task queue is full!");
+      }
+      break;
+    case OverflowPolicy::Reject:
+      break;
+  }
+  return false;
+}
+
+void ThreadPool::run_in_caller(Task& task)
+{
+  auto executed = std::move(task);
+  try {
+    executed();
+  } catch (...) {
+    const std::lock_guard lock(_error_mutex);
+    if (_error_handler) {
+      _error_handler(std::current_exception());
+    }
+  }
+}
+
+bool ThreadPool::push_blocking(Task& task)
+{
+  const auto deadline = std::chrono::steady_clock::now() + _overflow_timeout.load(std::memory_order_relaxed);
+  std::unique_lock lock(_space_mutex);
+  _space_waiters.fetch_add(1, std::memory_order_seq_cst);
+  // Pairs with the fence in notify_space(): either the worker sees this waiter, or this thread sees free space.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  bool pushed = false;
+  while (!(pushed = try_push_task(task)) && !_joined.load(std::memory_order_acquire) &&
+         _running.load(std::memory_order_acquire)) {
+    if (_space_cv.wait_until(lock, deadline) == std::cv_status::timeout) {
+      pushed = try_push_task(task);
+      break;
+    }
+  }
+  _space_waiters.fetch_sub(1, std::memory_order_release);
+  return pushed;
+}
+
+void ThreadPool::notify_space()
+{
+  // Only Block policy waits for free space. A thread which blocked before the policy was changed waits
+  // for its timeout at most.
+  if (_max_task_queue_size == 0 || _overflow_policy.load(std::memory_order_relaxed) != OverflowPolicy::Block) {
+    return;
+  }
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (_space_waiters.load(std::memory_order_relaxed) == 0) {
+    return;
+  }
+  // One task frees one slot, so one waiter is woken up.
+  const std::lock_guard lock(_space_mutex);
+  _space_cv.notify_one();
+}
+
+void ThreadPool::set_error_handler(ErrorHandler handler)
+{
+  const std::lock_guard lock(_error_mutex);
+  _error_handler = std::move(handler);
 }
 
 void ThreadPool::reset(std::uint32_t thread_count)
 {
+  interrupt();
   _thread_count = thread_count ? thread_count : 1;
   reset();
 }
@@ -47,6 +445,12 @@ void ThreadPool::reset()
 {
   interrupt();
   _threads.reset(new std::thread[_thread_count]);
+  if (is_work_stealing()) {
+    _local_tasks.reset(new WorkStealingQueue[_thread_count]);
+  }
+  _tasks.acquire();
+  _running.store(true, std::memory_order_release);
+  create_threads();
 }
 
 void ThreadPool::pause() { _paused.store(true, std::memory_order_release); }
@@ -64,6 +468,26 @@ void ThreadPool::interrupt()
     for (std::uint32_t i = 0; i < _thread_count; ++i) {
       _threads[i].join();
     }
+    if (is_work_stealing()) {
+      // Tasks left in the local deques and node queues stay queued in the injection queue.
+      Task task;
+      for (std::uint32_t i = 0; i < _thread_count; ++i) {
+        while (_local_tasks[i].pop(task)) {
+          _local_tasks_total.fetch_sub(1, std::memory_order_release);
+          if (!_tasks.push(std::move(task))) {
+            _tasks_total.fetch_sub(1, std::memory_order_release);
+          }
+        }
+      }
+      for (auto& pQueue : _node_tasks) {
+        while (pQueue->try_pop(task)) {
+          _local_tasks_total.fetch_sub(1, std::memory_order_release);
+          if (!_tasks.push(std::move(task))) {
+            _tasks_total.fetch_sub(1, std::memory_order_release);
+          }
+        }
+      }
+    }
   }
 }
 
@@ -73,7 +497,8 @@ void ThreadPool::join_all()
     _joined.store(true, std::memory_order_release);
     {
       std::unique_lock lock(_finish_mutex);
-      _finish_cv.wait(lock, [this] { return get_queued_task_count() == 0; });
+      // Running tasks are waited too, a reentrant task may be pushed back to the queue while it is running.
+      _finish_cv.wait(lock, [this] { return _tasks_total.load(std::memory_order_acquire) == 0; });
     }
     unblock();
     for (std::uint32_t i = 0; i < _thread_count; ++i) {
@@ -89,30 +514,280 @@ void ThreadPool::unblock()
     resume();
   }
   _tasks.release();
+  {
+    const std::lock_guard lock(_idle_mutex);
+    _idle_cv.notify_all();
+  }
+  {
+    const std::lock_guard lock(_space_mutex);
+    _space_cv.notify_all();
+  }
 }
 
 void ThreadPool::create_threads()
 {
+#ifdef CORE_ENABLE_METRICS
+  _worker_metrics.reset(new WorkerMetrics[_thread_count]);
+  _metrics_start = std::chrono::steady_clock::now();
+#endif
+  place_threads();
   for (std::uint32_t i = 0; i < _thread_count; i++) {
-    _threads[i] = std::thread(&ThreadPool::run, this);
+    if (is_work_stealing()) {
+      _threads[i] = std::thread(&ThreadPool::run_stealing, this, i);
+    } else {
+      _threads[i] = std::thread(&ThreadPool::run, this, i);
+    }
+    if (!_thread_cpus[i].empty()) {
+      CpuTopology::set_affinity(_threads[i], _thread_cpus[i]);
+    }
   }
 }
 
-void ThreadPool::run()
+void ThreadPool::place_threads()
 {
+  _thread_cpus.assign(_thread_count, {});
+  _thread_nodes.assign(_thread_count, 0);
+  _node_threads.assign(std::max<std::size_t>(_numa_nodes.size(), 1), {});
+  const auto node_count = static_cast<std::uint32_t>(_numa_nodes.size());
+  for (std::uint32_t i = 0; i < _thread_count; ++i) {
+    // Threads are split between nodes in contiguous blocks, explicitly pinned threads belong to the node of their CPU.
+    auto node = node_count != 0 ? static_cast<std::uint32_t>(std::uint64_t{i} * node_count / _thread_count) : 0;
+    if (!_cpu_affinity.empty()) {
+      const auto cpu = _cpu_affinity[i % _cpu_affinity.size()];
+      _thread_cpus[i] = {cpu};
+      if (cpu < _cpu_nodes.size() && _cpu_nodes[cpu] >= 0) {
+        node = static_cast<std::uint32_t>(_cpu_nodes[cpu]);
+      }
+    } else if (node_count != 0) {
+      _thread_cpus[i] = _numa_nodes[node].cpus;
+    }
+    _thread_nodes[i] = node;
+    _node_threads[node].push_back(i);
+  }
+}
+
+std::int32_t ThreadPool::current_node() const
+{
+  if (_policy != SchedulingPolicy::NumaWorkStealing) {
+    return -1;
+  }
+  const auto cpu = CpuTopology::current_cpu();
+  return cpu && *cpu < _cpu_nodes.size() ? _cpu_nodes[*cpu] : -1;
+}
+
+void ThreadPool::run(std::uint32_t index)
+{
+  current_index = index;
+#ifdef CORE_ENABLE_TRACING
+  TraceRecorder::instance().set_thread_name("worker " + std::to_string(index));
+#endif
   while (_running) {
     if (_paused.load(std::memory_order_acquire)) {
       std::unique_lock lock(_pause_mutex);
       _pause_cv.wait(lock, [this] { return !_paused.load(std::memory_order_acquire); });
     }
     if (_joined.load(std::memory_order_acquire) && get_queued_task_count() == 0) {
-      _finish_cv.notify_one();
+      notify_finish();
     }
     auto task = _tasks.pop();
     if (!task.empty()) {
-      task();
+      execute(task);
+    }
+  }
+}
+
+void ThreadPool::run_stealing(std::uint32_t index)
+{
+  current_pool = this;
+  current_index = index;
+#ifdef CORE_ENABLE_TRACING
+  TraceRecorder::instance().set_thread_name("worker " + std::to_string(index));
+#endif
+  victim_seed = index + 1;
+  while (_running) {
+    if (_paused.load(std::memory_order_acquire)) {
+      std::unique_lock lock(_pause_mutex);
+      _pause_cv.wait(lock, [this] { return !_paused.load(std::memory_order_acquire); });
+    }
+    if (_joined.load(std::memory_order_acquire) && get_queued_task_count() == 0) {
+      notify_finish();
+    }
+    Task task;
+    if (find_task(index, task)) {
+      execute(task);
+      continue;
+    }
+    std::unique_lock lock(_idle_mutex);
+    _idle_count.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    _idle_cv.wait(lock, [this] { return !_running.load(std::memory_order_acquire) || get_queued_task_count() != 0; });
+    _idle_count.fetch_sub(1, std::memory_order_release);
+  }
+  current_pool = nullptr;
+}
+
+bool ThreadPool::find_task(std::uint32_t index, Task& task)
+{
+  if (_local_tasks[index].pop(task)) {
+    _local_tasks_total.fetch_sub(1, std::memory_order_release);
+    return true;
+  }
+  if (_policy == SchedulingPolicy::NumaWorkStealing) {
+    return find_numa_task(index, task);
+  }
+  if (_tasks.try_pop(task)) {
+    return true;
+  }
+  if (_local_tasks_total.load(std::memory_order_acquire) == 0) {
+    return false;
+  }
+  return steal_task(index, _node_threads.front(), task);
+}
+
+bool ThreadPool::find_numa_task(std::uint32_t index, Task& task)
+{
+  const auto node = _thread_nodes[index];
+  if (_local_tasks_total.load(std::memory_order_acquire) != 0) {
+    if (_node_tasks[node]->try_pop(task)) {
+      _local_tasks_total.fetch_sub(1, std::memory_order_release);
+      return true;
+    }
+    if (steal_task(index, _node_threads[node], task)) {
+      return true;
+    }
+  }
+  if (_tasks.try_pop(task)) {
+    return true;
+  }
+  if (_local_tasks_total.load(std::memory_order_acquire) == 0) {
+    return false;
+  }
+  // Other nodes are visited in the same order by all threads of the node, starting from the next one.
+  for (std::size_t i = 1; i < _node_tasks.size(); ++i) {
+    const auto other = (node + i) % _node_tasks.size();
+    if (_node_tasks[other]->try_pop(task)) {
+      _local_tasks_total.fetch_sub(1, std::memory_order_release);
+      return true;
+    }
+    if (steal_task(index, _node_threads[other], task)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ThreadPool::steal_task(std::uint32_t index, std::span<const std::uint32_t> victims, Task& task)
+{
+  if (victims.empty()) {
+    return false;
+  }
+  const std::size_t first_victim = next_victim_seed() % victims.size();
+  for (std::size_t i = 0; i < victims.size(); ++i) {
+    const auto victim = victims[(first_victim + i) % victims.size()];
+    if (victim != index && _local_tasks[victim].steal(task)) {
+      _local_tasks_total.fetch_sub(1, std::memory_order_release);
+#ifdef CORE_ENABLE_METRICS
+      WorkerMetrics::add(_worker_metrics[index].stolen, 1);
+#endif
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::wake_workers(std::size_t count)
+{
+  // Pairs with the fence in run_stealing(): either the sleeping thread sees the new task,
+  // or this thread sees the sleeping one.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (_idle_count.load(std::memory_order_relaxed) == 0) {
+    return;
+  }
+  const std::lock_guard lock(_idle_mutex);
+  if (count >= _idle_count.load(std::memory_order_relaxed)) {
+    _idle_cv.notify_all();
+  } else {
+    for (std::size_t i = 0; i < count; ++i) {
+      _idle_cv.notify_one();
+    }
+  }
+}
+
+void ThreadPool::execute(Task& task)
+{
+  notify_space();
+  // A rescheduled task may be picked up by the same thread again, it is counted only once.
+  if (task.is_reentrant()) {
+    if (task.mark_rescheduled()) {
+      _reentrant_tasks.fetch_add(1, std::memory_order_relaxed);
+      if (_thread_count > 1 && reschedule(task)) {
+        return;
+      }
+    } else if (task.execution_policy() == ExecutionPolicy::Inline) {
+      _reentrant_tasks.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  if (task.is_expired()) {
+    _expired_tasks.fetch_add(1, std::memory_order_relaxed);
+    if (_expired_policy.load(std::memory_order_relaxed) == ExpiredTaskPolicy::Drop && task.is_droppable()) {
+      task = Task();
       _tasks_total.fetch_sub(1, std::memory_order_release);
+      return;
+    }
+  }
+#ifdef CORE_ENABLE_METRICS
+  auto& metrics = _worker_metrics[current_index];
+  const auto priority = static_cast<std::size_t>(task.priority());
+  const auto start = Task::Clock::now();
+  metrics.queue_wait[priority].record(start - task.enqueue_time());
+#endif
+#ifdef CORE_ENABLE_TRACING
+  const auto trace_start = TraceRecorder::instance().is_enabled() ? TraceRecorder::now() : 0;
+#endif
+  try {
+    task();
+  } catch (...) {
+#ifdef CORE_ENABLE_METRICS
+    WorkerMetrics::add(metrics.failed, 1);
+#endif
+    const std::lock_guard lock(_error_mutex);
+    if (_error_handler) {
+      _error_handler(std::current_exception());
     }
   }
+#ifdef CORE_ENABLE_METRICS
+  const auto busy = std::chrono::duration_cast<std::chrono::nanoseconds>(Task::Clock::now() - start);
+  metrics.execution[priority].record(busy);
+  WorkerMetrics::add(metrics.busy_time, static_cast<std::uint64_t>(busy.count()));
+  WorkerMetrics::add(metrics.executed, 1);
+#endif
+#ifdef CORE_ENABLE_TRACING
+  if (trace_start != 0) {
+    TraceRecorder::instance().record({"execute", "task", trace_start, TraceRecorder::now() - trace_start,
+                                      task.trace_id(), task.trace_id() ? TraceFlow::In : TraceFlow::None});
+  }
+#endif
+  _tasks_total.fetch_sub(1, std::memory_order_release);
+}
+
+bool ThreadPool::reschedule(Task& task)
+{
+  if (!_running.load(std::memory_order_acquire)) {
+    return false;
+  }
+  mark_enqueued({&task, 1});
+  if (!_tasks.push(std::move(task))) {
+    return false;
+  }
+  if (is_work_stealing()) {
+    wake_workers(1);
+  }
+  return true;
+}
+
+void ThreadPool::notify_finish()
+{
+  const std::lock_guard lock(_finish_mutex);
+  _finish_cv.notify_one();
 }
 }  // namespace core
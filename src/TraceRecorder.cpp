@@ -0,0 +1,222 @@
+#include "TraceRecorder.hpp"
+
+#include <json/json.h>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+namespace core {
+
+/**
+ * @brief Trace state of the current thread.
+ */
+struct ThreadTrace {
+  std::shared_ptr<TraceRecorder::Buffer> buffer;
+  std::uint64_t generation = 0;
+  std::uint32_t thread_id = 0;
+  std::string name;
+};
+
+namespace {
+thread_local ThreadTrace thread_trace;
+
+/**
+ * @brief Write nanoseconds as microseconds used by Chrome trace format.
+ */
+void write_microseconds(std::ostream& stream, std::uint64_t ns)
+{
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%llu.%03llu", static_cast<unsigned long long>(ns / 1000),
+                static_cast<unsigned long long>(ns % 1000));
+  stream << buffer;
+}
+}  // namespace
+
+TraceRecorder::Buffer::Buffer(std::size_t capacity, std::uint32_t thread_id, std::string thread_name)
+    : thread_id(thread_id),
+      thread_name(std::move(thread_name)),
+      _slots(new Slot[capacity]),
+      _mask(capacity - 1),
+      _head(0)
+{
+}
+
+void TraceRecorder::Buffer::push(const TraceRecord& record)
+{
+  const auto head = _head.load(std::memory_order_relaxed);
+  auto& slot = _slots[head & _mask];
+  // Readers which see any field of the new slice also see the reset sequence, see copy().
+  slot.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.name.store(record.name, std::memory_order_relaxed);
+  slot.category.store(record.category, std::memory_order_relaxed);
+  slot.timestamp.store(record.timestamp, std::memory_order_relaxed);
+  slot.duration.store(record.duration, std::memory_order_relaxed);
+  slot.flow_id.store(record.flow_id, std::memory_order_relaxed);
+  slot.flow.store(record.flow, std::memory_order_relaxed);
+  slot.sequence.store(head + 1, std::memory_order_release);
+  _head.store(head + 1, std::memory_order_release);
+}
+
+void TraceRecorder::Buffer::copy(std::vector<TraceRecord>& records) const
+{
+  const auto head = _head.load(std::memory_order_acquire);
+  const auto capacity = _mask + 1;
+  for (auto i = head > capacity ? head - capacity : 0; i < head; ++i) {
+    const auto& slot = _slots[i & _mask];
+    // The slot is skipped if the writer has overwritten it or is overwriting it now.
+    if (slot.sequence.load(std::memory_order_acquire) != i + 1) {
+      continue;
+    }
+    TraceRecord record{slot.name.load(std::memory_order_relaxed), slot.category.load(std::memory_order_relaxed),
+                       slot.timestamp.load(std::memory_order_relaxed), slot.duration.load(std::memory_order_relaxed),
+                       slot.flow_id.load(std::memory_order_relaxed), slot.flow.load(std::memory_order_relaxed)};
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) == i + 1) {
+      records.push_back(record);
+    }
+  }
+}
+
+TraceRecorder::TraceRecorder()
+    : _enabled(false), _generation(1), _flow_id(1), _origin(0), _capacity(default_capacity), _next_thread_id(1)
+{
+}
+
+TraceRecorder& TraceRecorder::instance()
+{
+  static auto* recorder = new TraceRecorder();
+  return *recorder;
+}
+
+void TraceRecorder::start(std::size_t capacity)
+{
+  {
+    const std::lock_guard lock(_mutex);
+    _capacity = std::bit_ceil(std::max<std::size_t>(capacity, 1));
+    _buffers.clear();
+    _generation.fetch_add(1, std::memory_order_release);
+    _origin.store(now(), std::memory_order_relaxed);
+  }
+  _enabled.store(true, std::memory_order_release);
+}
+
+void TraceRecorder::stop() { _enabled.store(false, std::memory_order_release); }
+
+void TraceRecorder::clear()
+{
+  const std::lock_guard lock(_mutex);
+  _buffers.clear();
+  _generation.fetch_add(1, std::memory_order_release);
+}
+
+void TraceRecorder::record(const TraceRecord& record)
+{
+  if (!is_enabled()) {
+    return;
+  }
+  auto& state = thread_trace;
+  if (state.generation != _generation.load(std::memory_order_acquire)) {
+    state.buffer = register_thread(state.name);
+  }
+  state.buffer->push(record);
+}
+
+void TraceRecorder::set_thread_name(std::string name)
+{
+  auto& state = thread_trace;
+  state.name = std::move(name);
+  const std::lock_guard lock(_mutex);
+  if (state.buffer && state.generation == _generation.load(std::memory_order_relaxed)) {
+    state.buffer->thread_name = state.name;
+  }
+}
+
+std::shared_ptr<TraceRecorder::Buffer> TraceRecorder::register_thread(const std::string& name)
+{
+  auto& state = thread_trace;
+  const std::lock_guard lock(_mutex);
+  if (state.thread_id == 0) {
+    state.thread_id = _next_thread_id++;
+  }
+  state.generation = _generation.load(std::memory_order_relaxed);
+  _buffers.push_back(std::make_shared<Buffer>(_capacity, state.thread_id, name));
+  return _buffers.back();
+}
+
+std::vector<TraceRecord> TraceRecorder::records() const
+{
+  std::vector<TraceRecord> records;
+  const std::lock_guard lock(_mutex);
+  for (const auto& pBuffer : _buffers) {
+    pBuffer->copy(records);
+  }
+  return records;
+}
+
+void TraceRecorder::dump(std::ostream& stream) const
+{
+  std::vector<std::shared_ptr<Buffer>> buffers;
+  std::vector<std::string> names;
+  {
+    const std::lock_guard lock(_mutex);
+    buffers = _buffers;
+    for (const auto& pBuffer : buffers) {
+      names.push_back(pBuffer->thread_name);
+    }
+  }
+  const auto origin = _origin.load(std::memory_order_relaxed);
+  bool first = true;
+  const auto separator = [&stream, &first] {
+    stream << (first ? "\n" : ",\n");
+    first = false;
+  };
+
+  stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  std::vector<TraceRecord> records;
+  for (std::size_t i = 0; i < buffers.size(); ++i) {
+    const auto tid = buffers[i]->thread_id;
+    if (!names[i].empty()) {
+      separator();
+      stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+             << ",\"args\":{\"name\":" << Json::valueToQuotedString(names[i].c_str()) << "}}";
+    }
+    records.clear();
+    buffers[i]->copy(records);
+    for (const auto& record : records) {
+      separator();
+      stream << "{\"name\":" << Json::valueToQuotedString(record.name)
+             << ",\"cat\":" << Json::valueToQuotedString(record.category) << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+             << ",\"ts\":";
+      write_microseconds(stream, record.timestamp > origin ? record.timestamp - origin : 0);
+      stream << ",\"dur\":";
+      write_microseconds(stream, record.duration);
+      if (record.flow != TraceFlow::None) {
+        stream << ",\"bind_id\":\"0x" << std::hex << record.flow_id << std::dec << "\""
+               << (record.flow == TraceFlow::Out ? ",\"flow_out\":true" : ",\"flow_in\":true");
+      }
+      stream << "}";
+    }
+  }
+  stream << "\n]}\n";
+}
+
+bool TraceRecorder::dump(const std::string& path) const
+{
+  std::ofstream stream(path);
+  if (!stream) {
+    return false;
+  }
+  dump(stream);
+  return static_cast<bool>(stream);
+}
+
+std::uint64_t TraceRecorder::now()
+{
+  return static_cast<std::uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+}  // namespace core
@@ -0,0 +1,58 @@
+#include "WorkStealingQueue.hpp"
+
+namespace core {
+
+WorkStealingQueue::WorkStealingQueue() : _size(0) {}
+
+void WorkStealingQueue::push(Task&& task)
+{
+  const std::lock_guard lock(_mutex);
+  _lanes.push_back(std::move(task));
+  _size.fetch_add(1, std::memory_order_release);
+}
+
+void WorkStealingQueue::push_bulk(std::span<Task> tasks)
+{
+  const std::lock_guard lock(_mutex);
+  for (auto& task : tasks) {
+    _lanes.push_back(std::move(task));
+  }
+  _size.fetch_add(static_cast<std::uint32_t>(tasks.size()), std::memory_order_release);
+}
+
+bool WorkStealingQueue::pop(Task& task)
+{
+  if (_size.load(std::memory_order_acquire) == 0) {
+    return false;
+  }
+  const std::lock_guard lock(_mutex);
+  if (!_lanes.pop_back(task)) {
+    return false;
+  }
+  _size.fetch_sub(1, std::memory_order_release);
+  return true;
+}
+
+bool WorkStealingQueue::steal(Task& task)
+{
+  if (_size.load(std::memory_order_acquire) == 0) {
+    return false;
+  }
+  const std::lock_guard lock(_mutex);
+  if (!_lanes.pop_front(task)) {
+    return false;
+  }
+  _size.fetch_sub(1, std::memory_order_release);
+  return true;
+}
+
+std::uint32_t WorkStealingQueue::size() const { return _size.load(std::memory_order_acquire); }
+bool WorkStealingQueue::empty() const { return _size.load(std::memory_order_acquire) == 0; }
+
+void WorkStealingQueue::clear()
+{
+  const std::lock_guard lock(_mutex);
+  _lanes.clear();
+  _size.store(0, std::memory_order_release);
+}
+}  // namespace core
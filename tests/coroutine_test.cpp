@@ -0,0 +1,200 @@
+#include "Event.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+
+namespace {
+
+/**
+ * Minimal eagerly started coroutine without result.
+ */
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+int sum(int a, int b) { return a + b; }
+
+}  // namespace
+
+TEST(CoroutineTest, test_schedule_resumes_in_pool_thread)
+{
+    core::ThreadPool pool(2, 0);
+    std::promise<std::thread::id> resumed;
+    auto resumed_future = resumed.get_future();
+
+    [](core::ThreadPool& pool, std::promise<std::thread::id>& resumed) -> Detached {
+        co_await pool.schedule();
+        resumed.set_value(std::this_thread::get_id());
+    }(pool, resumed);
+
+    EXPECT_NE(resumed_future.get(), std::this_thread::get_id());
+}
+
+TEST(CoroutineTest, test_schedule_under_overflow_policies)
+{
+    const auto resume = [](core::ThreadPool& pool, std::promise<std::thread::id>& resumed) -> Detached {
+        co_await pool.schedule();
+        resumed.set_value(std::this_thread::get_id());
+    };
+    for (const auto policy : {core::OverflowPolicy::Reject, core::OverflowPolicy::Block, core::OverflowPolicy::CallerRuns,
+                              core::OverflowPolicy::DropOldest, core::OverflowPolicy::Throw}) {
+        SCOPED_TRACE(static_cast<int>(policy));
+        core::ThreadPool pool(1, 1);
+        pool.set_overflow_policy(policy, std::chrono::milliseconds(10));
+        std::promise<void> gate;
+        pool.post([gate_future = gate.get_future()] { gate_future.wait(); });
+        while (pool.get_queued_task_count() != 0) {
+            std::this_thread::yield();
+        }
+
+        // The first coroutine fills the queue, the second one continues in the current thread.
+        std::promise<std::thread::id> queued, rejected;
+        resume(pool, queued);
+        resume(pool, rejected);
+        auto rejected_future = rejected.get_future();
+        ASSERT_EQ(rejected_future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+        EXPECT_EQ(rejected_future.get(), std::this_thread::get_id());
+
+        core::Task task;
+        std::ignore = task.assign([] {});
+        if (policy == core::OverflowPolicy::Throw) {
+            EXPECT_THROW(pool.push_task(std::move(task)), std::overflow_error);
+        } else {
+            pool.push_task(std::move(task));
+        }
+        gate.set_value();
+        auto queued_future = queued.get_future();
+        ASSERT_EQ(queued_future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+        // The coroutine evicted by DropOldest is resumed by the pushing thread.
+        EXPECT_EQ(queued_future.get() == std::this_thread::get_id(), policy == core::OverflowPolicy::DropOldest);
+    }
+}
+
+TEST(CoroutineTest, test_await_task_result)
+{
+    core::ThreadPool pool(2, 0);
+    std::promise<int> value;
+    std::promise<bool> error;
+    auto value_future = value.get_future();
+    auto error_future = error.get_future();
+
+    core::Task first;
+    auto first_result = first.assign_awaitable(&sum, 2, 3);
+    core::Task second;
+    auto second_result = second.assign_awaitable([] { throw std::runtime_error("task failed"); });
+
+    [](core::TaskAwaitable<int> first_result, core::TaskAwaitable<void> second_result, std::promise<int>& value,
+       std::promise<bool>& error) -> Detached {
+        value.set_value(co_await first_result);
+        try {
+            co_await second_result;
+            error.set_value(false);
+        } catch (const std::runtime_error&) {
+            error.set_value(true);
+        }
+    }(std::move(first_result), std::move(second_result), value, error);
+
+    EXPECT_TRUE(pool.push_task(std::move(first)));
+    EXPECT_TRUE(pool.push_task(std::move(second)));
+    EXPECT_EQ(value_future.get(), 5);
+    EXPECT_TRUE(error_future.get());
+}
+
+TEST(CoroutineTest, test_dropped_task_breaks_result)
+{
+    std::promise<bool> broken;
+    auto broken_future = broken.get_future();
+    {
+        core::Task task;
+        auto result = task.assign_awaitable([] { return 1; });
+        [](core::TaskAwaitable<int> result, std::promise<bool>& broken) -> Detached {
+            try {
+                co_await result;
+                broken.set_value(false);
+            } catch (const std::future_error&) {
+                broken.set_value(true);
+            }
+        }(std::move(result), broken);
+    }
+    EXPECT_TRUE(broken_future.get());
+}
+
+TEST(CoroutineTest, test_await_event_notifications)
+{
+    core::Event<int> event;
+    std::atomic_int total = 0;
+    for (int i = 0; i < 1000; ++i) {
+        [](core::Event<int>& event, std::atomic_int& total) -> Detached {
+            total += co_await event.next();
+            total += co_await event.next();
+        }(event, total);
+    }
+
+    event.notify(nullptr, 1);
+    EXPECT_EQ(total.load(), 1000);
+    event.notify(nullptr, 2);
+    EXPECT_EQ(total.load(), 3000);
+    event.notify(nullptr, 4);
+    EXPECT_EQ(total.load(), 3000);
+}
+
+TEST(CoroutineTest, test_await_void_event_in_pool)
+{
+    core::Event<void> event;
+    event.init_thread_pool(2, 0);
+    std::promise<std::thread::id> resumed;
+    auto resumed_future = resumed.get_future();
+
+    [](core::Event<void>& event, std::promise<std::thread::id>& resumed) -> Detached {
+        co_await event.next();
+        resumed.set_value(std::this_thread::get_id());
+    }(event, resumed);
+
+    event.notify_async(nullptr);
+    EXPECT_NE(resumed_future.get(), std::this_thread::get_id());
+}
+
+TEST(CoroutineTest, test_rejected_event_waiters_are_resumed_in_caller)
+{
+    core::Event<int> event;
+    event.init_thread_pool(1, 1);
+    auto& pool = *event.get_thread_pool();
+    std::promise<void> gate;
+    pool.post([gate_future = gate.get_future()] { gate_future.wait(); });
+    while (pool.get_queued_task_count() != 0) {
+        std::this_thread::yield();
+    }
+
+    std::atomic_int total = 0;
+    std::thread::id resumed;
+    for (int i = 0; i < 3; ++i) {
+        [](core::Event<int>& event, std::atomic_int& total, std::thread::id& resumed) -> Detached {
+            total += co_await event.next();
+            resumed = std::this_thread::get_id();
+        }(event, total, resumed);
+    }
+
+    // The first resumption fills the queue, the rejected ones are not droppable and run in the notifying thread.
+    event.notify_async(nullptr, 1);
+    EXPECT_EQ(total.load(), 2);
+    EXPECT_EQ(resumed, std::this_thread::get_id());
+    EXPECT_EQ(pool.get_overflow_stats().caller_runs, 2);
+    EXPECT_EQ(pool.get_overflow_stats().rejected, 0);
+    gate.set_value();
+    pool.join_all();
+    EXPECT_EQ(total.load(), 3);
+}
@@ -0,0 +1,28 @@
+#include "CpuTopology.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+TEST(CpuTopologyTest, test_parse_cpu_list)
+{
+    EXPECT_EQ(core::CpuTopology::parse_cpu_list("0-3,8,10-11"), (std::vector<std::uint32_t>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(core::CpuTopology::parse_cpu_list("5\n"), std::vector<std::uint32_t>{5});
+    EXPECT_EQ(core::CpuTopology::parse_cpu_list("3-1,x,2"), std::vector<std::uint32_t>{2});
+    EXPECT_TRUE(core::CpuTopology::parse_cpu_list("").empty());
+}
+
+TEST(CpuTopologyTest, test_numa_nodes_cover_allowed_cpus)
+{
+    const auto allowed = core::CpuTopology::allowed_cpus();
+    ASSERT_FALSE(allowed.empty());
+    std::vector<std::uint32_t> cpus;
+    for (const auto& node : core::CpuTopology::numa_nodes()) {
+        EXPECT_FALSE(node.cpus.empty());
+        cpus.insert(cpus.end(), node.cpus.begin(), node.cpus.end());
+    }
+    std::sort(cpus.begin(), cpus.end());
+    EXPECT_EQ(cpus, allowed);
+}
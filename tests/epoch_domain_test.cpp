@@ -0,0 +1,58 @@
+#include "EpochDomain.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+
+namespace {
+
+struct Tracked {
+    explicit Tracked(std::atomic_int& destroyed) : destroyed_(destroyed) {}
+    ~Tracked() { destroyed_++; }
+
+    std::atomic_int& destroyed_;
+};
+
+}  // namespace
+
+TEST(EpochDomainTest, test_retired_object_outlives_read_section)
+{
+    auto& domain = core::EpochDomain::instance();
+    std::atomic_int destroyed = 0;
+    std::promise<void> entered;
+    std::promise<void> leave;
+    auto leave_future = leave.get_future();
+    auto reader = std::async(std::launch::async, [&entered, &leave_future] {
+        const core::EpochDomain::Guard guard;
+        entered.set_value();
+        leave_future.wait();
+    });
+    entered.get_future().wait();
+
+    domain.retire(new Tracked(destroyed));
+    domain.reclaim();
+    EXPECT_EQ(destroyed.load(), 0);
+
+    leave.set_value();
+    reader.wait();
+    domain.reclaim();
+    EXPECT_EQ(destroyed.load(), 1);
+}
+
+TEST(EpochDomainTest, test_nested_read_section)
+{
+    auto& domain = core::EpochDomain::instance();
+    std::atomic_int destroyed = 0;
+    {
+        const core::EpochDomain::Guard outer;
+        {
+            const core::EpochDomain::Guard inner;
+        }
+        domain.synchronize();
+        domain.retire(new Tracked(destroyed));
+        EXPECT_EQ(destroyed.load(), 0);
+    }
+    domain.reclaim();
+    EXPECT_EQ(destroyed.load(), 1);
+}
@@ -0,0 +1,190 @@
+#include "Event.hpp"
+#include "EventHandler.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace {
+
+class SlowConsumer {
+public:
+    void on_value(const void* psender, int value)
+    {
+        int expected = running.fetch_add(1);
+        EXPECT_EQ(expected, 0);
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        EXPECT_GT(value, last.load());
+        last = value;
+        calls++;
+        running--;
+    }
+
+    std::atomic_int running = 0;
+    std::atomic_int last = 0;
+    std::atomic_int calls = 0;
+};
+
+}  // namespace
+
+TEST(EventConflationTest, test_subscriber_receives_latest_value)
+{
+    SlowConsumer consumer;
+    core::Event<int> event;
+    event.init_thread_pool(2, 0);
+    auto subscription = event.subscribe_conflated(core::EventHandler::bind(&consumer, &SlowConsumer::on_value));
+    EXPECT_TRUE(subscription.connected());
+    EXPECT_FALSE(event.subscribe_conflated(core::EventHandler::bind(&consumer, &SlowConsumer::on_value)).connected());
+
+    constexpr int notifications = 10000;
+    for (int i = 1; i <= notifications; ++i) {
+        event.notify(nullptr, i);
+    }
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (consumer.last.load() != notifications && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(consumer.last.load(), notifications);
+    EXPECT_LT(consumer.calls.load(), notifications);
+}
+
+TEST(EventConflationTest, test_conflated_count)
+{
+    class BlockingConsumer {
+    public:
+        void on_value(const void* psender, int value)
+        {
+            while (!released.load()) {
+                std::this_thread::yield();
+            }
+            values.push_back(value);
+        }
+
+        std::atomic_bool released = false;
+        std::vector<int> values;
+    };
+
+    BlockingConsumer consumer;
+    {
+        core::ThreadPool pool(1, 0);
+        core::ConflatingEventHandler<int> handler(
+                core::EventHandler::bind(&consumer, &BlockingConsumer::on_value), pool);
+        handler.OnEvent(nullptr, 1);
+        handler.OnEvent(nullptr, 2);
+        handler.OnEvent(nullptr, 3);
+        EXPECT_EQ(handler.GetConflatedCount(), 2);
+        consumer.released = true;
+        pool.join_all();
+    }
+    ASSERT_FALSE(consumer.values.empty());
+    EXPECT_LE(consumer.values.size(), 2);
+    EXPECT_EQ(consumer.values.back(), 3);
+}
+
+TEST(EventConflationTest, test_expired_delivery_is_dropped)
+{
+    struct Collector {
+        void on_value(const void* psender, int value) { values.push_back(value); }
+
+        std::vector<int> values;
+    };
+
+    Collector collector;
+    core::ThreadPool pool(1, 0);
+    pool.set_expired_task_policy(core::ExpiredTaskPolicy::Drop);
+    core::ConflatingEventHandler<int> handler(
+            core::EventHandler::bind(&collector, &Collector::on_value), pool, core::TaskPriority::High,
+            std::chrono::milliseconds(1));
+
+    std::promise<void> gate;
+    pool.post([gate_future = gate.get_future()] { gate_future.wait(); });
+    while (pool.get_queued_task_count() != 0) {
+        std::this_thread::yield();
+    }
+    handler.OnEvent(nullptr, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    gate.set_value();
+    while (pool.get_total_task_count() != 0) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(pool.get_expired_task_count(), 1);
+    handler.OnEvent(nullptr, 2);
+    pool.join_all();
+    EXPECT_EQ(collector.values, (std::vector<int>{2}));
+}
+
+TEST(EventConflationTest, test_rejected_delivery_is_dropped)
+{
+    struct Collector {
+        void on_value(const void* psender, int value) { values.push_back(value); }
+
+        std::vector<int> values;
+    };
+
+    Collector collector;
+    core::ThreadPool pool(1, 1);
+    pool.set_overflow_policy(core::OverflowPolicy::Throw);
+    core::ConflatingEventHandler<int> handler(core::EventHandler::bind(&collector, &Collector::on_value), pool);
+
+    std::promise<void> gate;
+    pool.post([gate_future = gate.get_future()] { gate_future.wait(); });
+    while (pool.get_queued_task_count() != 0) {
+        std::this_thread::yield();
+    }
+    pool.post([] {});
+    // Delivery does not fit the queue, it is rejected without throwing from the notification.
+    EXPECT_NO_THROW(handler.OnEvent(nullptr, 1));
+    EXPECT_EQ(pool.get_overflow_stats().rejected, 1);
+    gate.set_value();
+    while (pool.get_total_task_count() != 0) {
+        std::this_thread::yield();
+    }
+    handler.OnEvent(nullptr, 2);
+    pool.join_all();
+    EXPECT_EQ(collector.values, (std::vector<int>{2}));
+}
+
+TEST(EventConflationTest, test_removal_from_handler_drops_pending_value)
+{
+    struct Collector {
+        void on_value(const void* psender, int value) { values.push_back(value); }
+
+        std::vector<int> values;
+    };
+    class Remover {
+    public:
+        void on_value(const void* psender, int value) { subscription.disconnect(); }
+
+        core::Subscription subscription;
+    };
+
+    Collector collector;
+    Remover remover;
+    core::Event<int> event;
+    event.init_thread_pool(1, 0);
+    auto& pool = *event.get_thread_pool();
+    std::promise<void> gate;
+    pool.post([gate_future = gate.get_future()] { gate_future.wait(); });
+    remover.subscription = event.subscribe_conflated(core::EventHandler::bind(&collector, &Collector::on_value));
+    event += core::EventHandler::bind(&remover, &Remover::on_value);
+
+    // Delivery is scheduled behind the gate and the subscription is removed by the next handler.
+    event.notify(nullptr, 1);
+    EXPECT_FALSE(remover.subscription.connected());
+    event.notify(nullptr, 2);
+    gate.set_value();
+    pool.join_all();
+    EXPECT_TRUE(collector.values.empty());
+}
+
+TEST(EventConflationTest, test_conflated_requires_thread_pool)
+{
+    SlowConsumer consumer;
+    core::Event<int> event;
+    EXPECT_THROW(event.subscribe_conflated(core::EventHandler::bind(&consumer, &SlowConsumer::on_value)),
+                 std::domain_error);
+}
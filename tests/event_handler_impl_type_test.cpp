@@ -57,6 +57,7 @@ TEST(EvenHandlerImplTypeTest, test_on_same_type_member_function)
     EXPECT_FALSE(custom_handler.IsBindedToSameFunctionAs(nullptr));
 }
 
+#ifdef __GXX_RTTI
 TEST(EvenHandlerImplTypeTest, test_on_event_handler_result)
 {
     using ArgT = CustomArgumentStruct;
@@ -79,3 +80,23 @@ TEST(EvenHandlerImplTypeTest, test_on_event_handler_result)
             dynamic_cast<const core::EventHandlerImplForMemberFunction<decltype(entity_obj), ArgT>*>(custom_member_fnuction_handler.get());
     EXPECT_TRUE(pcustom_member_fnuction_handler != nullptr);
 }
+#endif
+
+TEST(EvenHandlerImplTypeTest, test_handler_key)
+{
+    using ArgT = CustomArgumentStruct;
+    ExecutableEntity<ArgT> entity_obj;
+    ExecutableEntity<ArgT> another_entity_obj;
+    const auto handler = core::EventHandler::bind(&entity_obj, &ExecutableEntity<ArgT>::primary_execute);
+    const auto same_handler = core::EventHandler::bind(&entity_obj, &ExecutableEntity<ArgT>::primary_execute);
+    const auto another_object_handler =
+            core::EventHandler::bind(&another_entity_obj, &ExecutableEntity<ArgT>::primary_execute);
+    const auto function_handler = core::EventHandler::bind(&custom_callback);
+
+    EXPECT_TRUE(handler->Key() == same_handler->Key());
+    EXPECT_TRUE(handler->IsBindedToSameFunctionAs(same_handler.get()));
+    EXPECT_TRUE(handler->IsSametype(another_object_handler.get()));
+    EXPECT_FALSE(handler->IsBindedToSameFunctionAs(another_object_handler.get()));
+    EXPECT_FALSE(handler->IsSametype(function_handler.get()));
+    EXPECT_FALSE(handler->IsBindedToSameFunctionAs(function_handler.get()));
+}
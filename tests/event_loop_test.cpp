@@ -0,0 +1,115 @@
+#include "Event.hpp"
+#include "EventHandler.hpp"
+#include "EventLoop.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+class Consumer {
+public:
+    void on_value(const void* psender, int value)
+    {
+        total += value;
+        thread_id = std::this_thread::get_id();
+    }
+    void on_signal(const void* psender) { signals++; }
+
+    int total = 0;
+    int signals = 0;
+    std::thread::id thread_id;
+};
+
+}  // namespace
+
+TEST(EventLoopTest, test_run_once_delivers_queued_notifications)
+{
+    Consumer consumer;
+    core::Event<int> event;
+    core::Event<void> voidEvent;
+    const auto loop = core::EventLoop::current();
+    auto subscription = event.subscribe(core::EventHandler::bind(&consumer, &Consumer::on_value), loop);
+    auto voidSubscription = voidEvent.subscribe(core::EventHandler::bind(&consumer, &Consumer::on_signal), loop);
+    EXPECT_TRUE(subscription.connected());
+    EXPECT_FALSE(event.subscribe(core::EventHandler::bind(&consumer, &Consumer::on_value), loop).connected());
+
+    event.notify(nullptr, 2);
+    event.notify(nullptr, 3);
+    voidEvent.notify(nullptr);
+    EXPECT_EQ(consumer.total, 0);
+    EXPECT_EQ(loop->size(), 3);
+    EXPECT_EQ(loop->run_once(), 3);
+    EXPECT_EQ(consumer.total, 5);
+    EXPECT_EQ(consumer.signals, 1);
+
+    // Messages posted before removal are skipped.
+    event.notify(nullptr, 4);
+    subscription.disconnect();
+    EXPECT_EQ(loop->run_once(), 1);
+    EXPECT_EQ(consumer.total, 5);
+}
+
+TEST(EventLoopTest, test_removal_from_handler_skips_queued_messages)
+{
+    class Remover {
+    public:
+        void on_value(const void* psender, int value) { subscription.disconnect(); }
+
+        core::Subscription subscription;
+    };
+
+    Consumer consumer;
+    Remover remover;
+    core::Event<int> event;
+    const auto loop = core::EventLoop::current();
+    remover.subscription = event.subscribe(core::EventHandler::bind(&consumer, &Consumer::on_value), loop);
+    event += core::EventHandler::bind(&remover, &Remover::on_value);
+
+    event.notify(nullptr, 2);
+    EXPECT_FALSE(remover.subscription.connected());
+    EXPECT_EQ(loop->run_once(), 1);
+    EXPECT_EQ(consumer.total, 0);
+    event.notify(nullptr, 3);
+    EXPECT_EQ(loop->run_once(), 0);
+    EXPECT_EQ(consumer.total, 0);
+}
+
+TEST(EventLoopTest, test_handlers_are_called_by_consumer_thread)
+{
+    Consumer consumer;
+    core::Event<int> event;
+    auto loop = std::make_shared<core::EventLoop>();
+    auto subscription = event.subscribe(core::EventHandler::bind(&consumer, &Consumer::on_value), loop);
+
+    std::thread consumerThread([loop] { loop->run(); });
+    const auto consumerId = consumerThread.get_id();
+    std::thread publisher([&event] {
+        for (int i = 0; i < 100; ++i) {
+            event.notify(nullptr, 1);
+        }
+    });
+    publisher.join();
+    loop->post([loop] { loop->stop(); });
+    consumerThread.join();
+
+    EXPECT_EQ(consumer.total, 100);
+    EXPECT_EQ(consumer.thread_id, consumerId);
+}
+
+TEST(EventLoopTest, test_run_once_keeps_messages_after_exception)
+{
+    core::EventLoop loop;
+    int executed = 0;
+    loop.post([&executed] { executed++; });
+    loop.post([] { throw std::runtime_error("message failed"); });
+    loop.post([&executed] { executed++; });
+
+    EXPECT_THROW(loop.run_once(), std::runtime_error);
+    EXPECT_EQ(executed, 1);
+    EXPECT_EQ(loop.run_once(), 1);
+    EXPECT_EQ(executed, 2);
+}
@@ -0,0 +1,732 @@
+#include "Event.hpp"
+#include "EventHandler.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+struct Payload {
+    Payload() = default;
+    Payload(const Payload& other) : data(other.data) { copies++; }
+    Payload(Payload&& other) noexcept = default;
+
+    std::vector<char> data = std::vector<char>(4096, 'x');
+    static inline std::atomic_int copies = 0;
+};
+
+class Receiver {
+public:
+    void on_value(const void* psender, int value) { total += value; }
+    void on_signal(const void* psender) { signals++; }
+    void on_signal_value(const void* psender, int value) { signals++; }
+
+    std::atomic_int total = 0;
+    std::atomic_int signals = 0;
+};
+
+}  // namespace
+
+TEST(EventNotificationTest, test_notify)
+{
+    Receiver first;
+    Receiver second;
+    core::Event<int> event;
+    event += core::EventHandler::bind(&first, &Receiver::on_value);
+    event += core::EventHandler::bind(&second, &Receiver::on_value);
+    event += core::EventHandler::bind(&second, &Receiver::on_value);
+
+    event.notify(nullptr, 3);
+    EXPECT_EQ(first.total.load(), 3);
+    EXPECT_EQ(second.total.load(), 3);
+
+    event -= core::EventHandler::bind(&first, &Receiver::on_value);
+    event.notify(nullptr, 2);
+    EXPECT_EQ(first.total.load(), 3);
+    EXPECT_EQ(second.total.load(), 5);
+}
+
+TEST(EventNotificationTest, test_notify_async_requires_thread_pool)
+{
+    core::Event<int> event;
+    EXPECT_THROW(event.notify_async(nullptr, 1), std::domain_error);
+}
+
+TEST(EventNotificationTest, test_notify_async)
+{
+    Receiver receivers[8];
+    core::Event<int> event;
+    event.init_thread_pool(2, 0);
+    for (auto& receiver : receivers) {
+        event += core::EventHandler::bind(&receiver, &Receiver::on_value);
+    }
+
+    auto results = event.notify_async(nullptr, 4);
+    EXPECT_EQ(results.size(), 8);
+    for (auto& result : results) {
+        EXPECT_TRUE(result.get());
+    }
+    for (auto& receiver : receivers) {
+        EXPECT_EQ(receiver.total.load(), 4);
+    }
+}
+
+TEST(EventNotificationTest, test_void_notify_async)
+{
+    Receiver receiver;
+    core::Event<void> event;
+    event.init_thread_pool(2, 0);
+    event += core::EventHandler::bind(&receiver, &Receiver::on_signal);
+
+    event.notify(nullptr);
+    for (auto& result : event.notify_async(nullptr)) {
+        EXPECT_TRUE(result.get());
+    }
+    EXPECT_EQ(receiver.signals.load(), 2);
+}
+
+TEST(EventNotificationTest, test_handler_removes_itself_during_notify)
+{
+    class SelfRemover {
+    public:
+        explicit SelfRemover(core::Event<int>& event) : event_(event) {}
+        void on_value(const void* psender, int value)
+        {
+            calls++;
+            event_ -= core::EventHandler::bind(this, &SelfRemover::on_value);
+        }
+
+        core::Event<int>& event_;
+        int calls = 0;
+    };
+
+    core::Event<int> event;
+    SelfRemover remover(event);
+    Receiver receiver;
+    event += core::EventHandler::bind(&remover, &SelfRemover::on_value);
+    event += core::EventHandler::bind(&receiver, &Receiver::on_value);
+
+    event.notify(nullptr, 1);
+    event.notify(nullptr, 1);
+    EXPECT_EQ(remover.calls, 1);
+    EXPECT_EQ(receiver.total.load(), 2);
+}
+
+TEST(EventNotificationTest, test_concurrent_notify_and_subscription)
+{
+    Receiver receivers[4];
+    Receiver stable;
+    core::Event<int> event;
+    event += core::EventHandler::bind(&stable, &Receiver::on_value);
+
+    std::atomic_bool running = true;
+    std::vector<std::thread> publishers;
+    for (int i = 0; i < 4; ++i) {
+        publishers.emplace_back([&event, &running] {
+            while (running.load()) {
+                event.notify(nullptr, 1);
+            }
+        });
+    }
+    for (int i = 0; i < 200; ++i) {
+        auto& receiver = receivers[i % 4];
+        event += core::EventHandler::bind(&receiver, &Receiver::on_value);
+        event -= core::EventHandler::bind(&receiver, &Receiver::on_value);
+    }
+
+    // Removed handlers are not called after operator-= returns.
+    int totals[4];
+    for (int i = 0; i < 4; ++i) {
+        totals[i] = receivers[i].total.load();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    running = false;
+    for (auto& publisher : publishers) {
+        publisher.join();
+    }
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(receivers[i].total.load(), totals[i]);
+    }
+    EXPECT_GT(stable.total.load(), 0);
+}
+
+TEST(EventNotificationTest, test_cross_thread_unsubscribe_during_notify)
+{
+    // Handlers of two events notified by different threads remove handlers of other events
+    // while both threads are inside notify().
+    class Remover {
+    public:
+        Remover(std::barrier<>& barrier, core::Event<int>& target, Receiver& receiver)
+            : barrier_(barrier), target_(target), receiver_(receiver)
+        {
+        }
+        void on_value(const void* psender, int value)
+        {
+            barrier_.arrive_and_wait();
+            target_ -= core::EventHandler::bind(&receiver_, &Receiver::on_value);
+        }
+
+    private:
+        std::barrier<>& barrier_;
+        core::Event<int>& target_;
+        Receiver& receiver_;
+    };
+
+    std::barrier<> barrier(2);
+    core::Event<int> a, b, c, d;
+    Receiver first, second;
+    Remover remover_a(barrier, c, first);
+    Remover remover_b(barrier, d, second);
+    a += core::EventHandler::bind(&remover_a, &Remover::on_value);
+    b += core::EventHandler::bind(&remover_b, &Remover::on_value);
+    c += core::EventHandler::bind(&first, &Receiver::on_value);
+    d += core::EventHandler::bind(&second, &Receiver::on_value);
+
+    std::thread notifier([&b] { b.notify(nullptr, 1); });
+    a.notify(nullptr, 1);
+    notifier.join();
+
+    c.notify(nullptr, 1);
+    d.notify(nullptr, 1);
+    EXPECT_EQ(first.total.load(), 0);
+    EXPECT_EQ(second.total.load(), 0);
+}
+
+TEST(EventNotificationTest, test_unsubscribe_does_not_wait_for_other_events)
+{
+    class Blocker {
+    public:
+        void on_value(const void* psender, int value)
+        {
+            entered.set_value();
+            release.get_future().wait();
+        }
+
+        std::promise<void> entered;
+        std::promise<void> release;
+    };
+
+    core::Event<int> slow, other;
+    Blocker blocker;
+    Receiver receiver;
+    slow += core::EventHandler::bind(&blocker, &Blocker::on_value);
+    other += core::EventHandler::bind(&receiver, &Receiver::on_value);
+
+    std::thread notifier([&slow] { slow.notify(nullptr, 1); });
+    blocker.entered.get_future().wait();
+    // Removal from another event is not stalled by the running handler.
+    other -= core::EventHandler::bind(&receiver, &Receiver::on_value);
+    other.notify(nullptr, 1);
+    blocker.release.set_value();
+    notifier.join();
+    EXPECT_EQ(receiver.total.load(), 0);
+}
+
+TEST(EventNotificationTest, test_delegate_is_trivially_copyable)
+{
+    static_assert(std::is_trivially_copyable_v<core::EventDelegate<int>>);
+    static_assert(std::is_trivially_copyable_v<core::EventDelegate<void>>);
+
+    Receiver receiver;
+    const auto delegate = core::EventDelegate<int>::bind(&receiver, &Receiver::on_value);
+    auto copy = delegate;
+    copy(nullptr, 5);
+    EXPECT_EQ(receiver.total.load(), 5);
+    EXPECT_TRUE(copy == delegate);
+    EXPECT_FALSE(copy == core::EventDelegate<int>::bind(&receiver, &Receiver::on_signal_value));
+    EXPECT_FALSE(core::EventDelegate<int>());
+}
+
+TEST(EventNotificationTest, test_custom_handler_impl)
+{
+    class CountingHandler : public core::EventHandlerImpl<int> {
+    public:
+        explicit CountingHandler(std::atomic_int& total)
+            : core::EventHandlerImpl<int>(core::EventHandlerKey::make<CountingHandler>(&total)), total_(total)
+        {
+        }
+        void OnEvent(const void* psender, const int& arg) override { total_ += arg; }
+        bool IsBindedToSameFunctionAs(const core::EventHandlerImplBase<int>* pHandler) const override
+        {
+            return pHandler && Key() == pHandler->Key();
+        }
+
+    private:
+        std::atomic_int& total_;
+    };
+
+    std::atomic_int total = 0;
+    core::Event<int> event;
+    event.init_thread_pool(1, 0);
+    event += std::make_unique<CountingHandler>(total);
+    event += std::make_unique<CountingHandler>(total);
+
+    event.notify(nullptr, 2);
+    for (auto& result : event.notify_async(nullptr, 3)) {
+        EXPECT_TRUE(result.get());
+    }
+    EXPECT_EQ(total.load(), 5);
+
+    event -= std::make_unique<CountingHandler>(total);
+    event.notify(nullptr, 2);
+    EXPECT_EQ(total.load(), 5);
+}
+
+TEST(EventNotificationTest, test_custom_handlers_are_indexed_by_key)
+{
+    class OrderedHandler : public core::EventHandlerImpl<int> {
+    public:
+        OrderedHandler(std::vector<int>& order, std::atomic_int& compares, int id)
+            : core::EventHandlerImpl<int>(core::EventHandlerKey::make<OrderedHandler>(&order, id))
+            , order_(order)
+            , compares_(compares)
+            , id_(id)
+        {
+        }
+        void OnEvent(const void* psender, const int& arg) override { order_.push_back(id_); }
+        bool IsBindedToSameFunctionAs(const core::EventHandlerImplBase<int>* pHandler) const override
+        {
+            compares_++;
+            return pHandler && Key() == pHandler->Key();
+        }
+
+    private:
+        std::vector<int>& order_;
+        std::atomic_int& compares_;
+        int id_;
+    };
+
+    std::vector<int> order;
+    std::atomic_int compares = 0;
+    core::Event<int> event;
+    for (int id = 0; id < 100; ++id) {
+        event += std::make_unique<OrderedHandler>(order, compares, id);
+    }
+    EXPECT_FALSE(event.subscribe(std::make_unique<OrderedHandler>(order, compares, 50)).connected());
+
+    // Removing handlers from the front and the back compacts the snapshot and keeps the order of the rest.
+    for (int id = 0; id < 45; ++id) {
+        event -= std::make_unique<OrderedHandler>(order, compares, id);
+        event -= std::make_unique<OrderedHandler>(order, compares, 99 - id);
+    }
+    event += std::make_unique<OrderedHandler>(order, compares, 0);
+    event.notify(nullptr, 1);
+    std::vector<int> expected;
+    for (int id = 45; id < 55; ++id) {
+        expected.push_back(id);
+    }
+    expected.push_back(0);
+    EXPECT_EQ(order, expected);
+    EXPECT_EQ(compares.load(), 0);
+}
+
+TEST(EventNotificationTest, test_subscription_token_disconnects)
+{
+    Receiver first;
+    Receiver second;
+    core::Event<int> event;
+    auto firstSubscription = event.subscribe(core::EventHandler::bind(&first, &Receiver::on_value));
+    {
+        auto secondSubscription = event.subscribe(core::EventHandler::bind(&second, &Receiver::on_value));
+        EXPECT_TRUE(secondSubscription.connected());
+        EXPECT_FALSE(event.subscribe(core::EventHandler::bind(&second, &Receiver::on_value)).connected());
+        event.notify(nullptr, 1);
+    }
+    event.notify(nullptr, 1);
+    EXPECT_EQ(first.total.load(), 2);
+    EXPECT_EQ(second.total.load(), 1);
+
+    auto moved = std::move(firstSubscription);
+    EXPECT_FALSE(firstSubscription.connected());
+    moved.disconnect();
+    EXPECT_FALSE(moved.connected());
+    event.notify(nullptr, 1);
+    EXPECT_EQ(first.total.load(), 2);
+}
+
+TEST(EventNotificationTest, test_unsubscribe_keeps_notification_order)
+{
+    class OrderedReceiver {
+    public:
+        OrderedReceiver(std::vector<int>& order, int id) : order_(order), id_(id) {}
+        void on_value(const void* psender, int value) { order_.push_back(id_); }
+
+    private:
+        std::vector<int>& order_;
+        int id_;
+    };
+
+    std::vector<int> order;
+    OrderedReceiver receivers[] = {{order, 0}, {order, 1}, {order, 2}, {order, 3}, {order, 4}};
+    core::Event<int> event;
+    std::vector<core::Subscription> subscriptions;
+    for (auto& receiver : receivers) {
+        subscriptions.push_back(event.subscribe(core::EventHandler::bind(&receiver, &OrderedReceiver::on_value)));
+    }
+
+    subscriptions[1].disconnect();
+    event -= core::EventHandler::bind(&receivers[3], &OrderedReceiver::on_value);
+    event.notify(nullptr, 1);
+    EXPECT_EQ(order, (std::vector<int>{0, 2, 4}));
+
+    // Tokens of shifted handlers still remove their own handlers.
+    order.clear();
+    subscriptions[4].disconnect();
+    subscriptions[1] = event.subscribe(core::EventHandler::bind(&receivers[1], &OrderedReceiver::on_value));
+    subscriptions[0].disconnect();
+    event.notify(nullptr, 1);
+    EXPECT_EQ(order, (std::vector<int>{2, 1}));
+}
+
+TEST(EventNotificationTest, test_stale_subscription_token)
+{
+    Receiver receiver;
+    Receiver other;
+    core::Event<int> event;
+    auto stale = event.subscribe(core::EventHandler::bind(&receiver, &Receiver::on_value));
+    auto otherSubscription = event.subscribe(core::EventHandler::bind(&other, &Receiver::on_value));
+    event -= core::EventHandler::bind(&receiver, &Receiver::on_value);
+
+    // The slot of the removed subscription is reused by the new one.
+    auto current = event.subscribe(core::EventHandler::bind(&receiver, &Receiver::on_value));
+    stale.disconnect();
+    event.notify(nullptr, 1);
+    EXPECT_EQ(receiver.total.load(), 1);
+    EXPECT_EQ(other.total.load(), 1);
+
+    core::Subscription outliving;
+    {
+        core::Event<int> local;
+        outliving = local.subscribe(core::EventHandler::bind(&receiver, &Receiver::on_value));
+        EXPECT_TRUE(outliving.connected());
+    }
+    EXPECT_FALSE(outliving.connected());
+}
+
+TEST(EventNotificationTest, test_token_disconnects_while_event_is_destroyed)
+{
+    Receiver receiver;
+    for (int i = 0; i < 200; ++i) {
+        auto event = std::make_unique<core::Event<int>>();
+        auto subscription = event->subscribe(core::EventHandler::bind(&receiver, &Receiver::on_value));
+        std::barrier start(2);
+        std::thread disconnecting([&] {
+            start.arrive_and_wait();
+            subscription.disconnect();
+        });
+        start.arrive_and_wait();
+        event.reset();
+        disconnecting.join();
+        EXPECT_FALSE(subscription.connected());
+    }
+}
+
+TEST(EventNotificationTest, test_token_ignores_unsubscribe_errors)
+{
+    class ThrowingHandler : public core::EventHandlerImpl<int> {
+    public:
+        explicit ThrowingHandler(std::atomic_int& total)
+            : core::EventHandlerImpl<int>(core::EventHandlerKey::make<ThrowingHandler>(&total)), total_(total)
+        {
+        }
+        void OnEvent(const void* psender, const int& arg) override { total_ += arg; }
+        bool IsBindedToSameFunctionAs(const core::EventHandlerImplBase<int>* pHandler) const override
+        {
+            return pHandler && Key() == pHandler->Key();
+        }
+        void OnUnsubscribed() override { throw std::runtime_error("unsubscribe failed"); }
+
+    private:
+        std::atomic_int& total_;
+    };
+
+    std::atomic_int total = 0;
+    core::Event<int> event;
+    auto subscription = event.subscribe(std::make_unique<ThrowingHandler>(total));
+    EXPECT_THROW(subscription.disconnect(), std::runtime_error);
+    EXPECT_FALSE(subscription.connected());
+    event.notify(nullptr, 1);
+    EXPECT_EQ(total.load(), 0);
+
+    {
+        auto destroyed = event.subscribe(std::make_unique<ThrowingHandler>(total));
+        EXPECT_TRUE(destroyed.connected());
+    }
+    auto assigned = event.subscribe(std::make_unique<ThrowingHandler>(total));
+    assigned = core::Subscription();
+    event.notify(nullptr, 1);
+    EXPECT_EQ(total.load(), 0);
+}
+
+TEST(EventNotificationTest, test_notify_async_batched)
+{
+    Receiver receivers[200];
+    Receiver signalReceiver;
+    core::Event<int> event;
+    core::Event<void> voidEvent;
+    event.init_thread_pool(4, 0);
+    voidEvent.init_thread_pool(2, 0);
+    for (auto& receiver : receivers) {
+        event += core::EventHandler::bind(&receiver, &Receiver::on_value);
+    }
+    voidEvent += core::EventHandler::bind(&signalReceiver, &Receiver::on_signal);
+
+    EXPECT_TRUE(event.notify_async_batched(nullptr, 2).get());
+    EXPECT_TRUE(event.notify_async_batched(nullptr, 3, 7).get());
+    EXPECT_TRUE(voidEvent.notify_async_batched(nullptr).get());
+    for (auto& receiver : receivers) {
+        EXPECT_EQ(receiver.total.load(), 5);
+    }
+    EXPECT_EQ(signalReceiver.signals.load(), 1);
+
+    core::Event<int> emptyEvent;
+    emptyEvent.init_thread_pool(1, 0);
+    EXPECT_TRUE(emptyEvent.notify_async_batched(nullptr, 1).get());
+}
+
+TEST(EventNotificationTest, test_notify_async_batched_rethrows)
+{
+    class Thrower {
+    public:
+        void on_value(const void* psender, int value) { throw std::runtime_error("handler failed"); }
+    };
+
+    Thrower thrower;
+    Receiver receiver;
+    core::Event<int> event;
+    event.init_thread_pool(2, 0);
+    event += core::EventHandler::bind(&thrower, &Thrower::on_value);
+    event += core::EventHandler::bind(&receiver, &Receiver::on_value);
+
+    auto result = event.notify_async_batched(nullptr, 1, 1);
+    EXPECT_THROW(result.get(), std::runtime_error);
+    EXPECT_EQ(receiver.total.load(), 1);
+}
+
+TEST(EventNotificationTest, test_notify_async_shared_payload)
+{
+
+    class PayloadReceiver {
+    public:
+        void on_payload(const void* psender, const Payload& payload) { size += payload.data.size(); }
+        std::atomic<std::size_t> size = 0;
+    };
+
+    Payload::copies = 0;
+    PayloadReceiver receivers[8];
+    core::Event<Payload> event;
+    event.init_thread_pool(2, 0);
+    for (auto& receiver : receivers) {
+        event += core::EventHandler::bind(&receiver, &PayloadReceiver::on_payload);
+    }
+
+    for (auto& result : event.notify_async(nullptr, Payload())) {
+        EXPECT_TRUE(result.get());
+    }
+    const auto pPayload = std::make_shared<const Payload>();
+    for (auto& result : event.notify_async(nullptr, pPayload)) {
+        EXPECT_TRUE(result.get());
+    }
+    EXPECT_EQ(Payload::copies.load(), 0);
+    EXPECT_EQ(event.get_payload_copy_count(), 0);
+    EXPECT_EQ(event.get_payload_alloc_count(), 1);
+    for (auto& receiver : receivers) {
+        EXPECT_EQ(receiver.size.load(), 2 * 4096);
+    }
+
+    for (auto& result : event.notify_async(nullptr, *pPayload)) {
+        EXPECT_TRUE(result.get());
+    }
+    EXPECT_EQ(event.get_payload_copy_count(), 8);
+    EXPECT_GE(Payload::copies.load(), 8);
+}
+
+TEST(EventNotificationTest, test_notify_async_applies_overflow_policy)
+{
+    for (const auto policy : {core::OverflowPolicy::Reject, core::OverflowPolicy::Block, core::OverflowPolicy::CallerRuns,
+                              core::OverflowPolicy::DropOldest, core::OverflowPolicy::Throw}) {
+        SCOPED_TRACE(static_cast<int>(policy));
+        Receiver receivers[4];
+        core::Event<int> event;
+        event.init_thread_pool(1, 1);
+        auto& pool = *event.get_thread_pool();
+        pool.set_overflow_policy(policy, std::chrono::milliseconds(10));
+        for (auto& receiver : receivers) {
+            event += core::EventHandler::bind(&receiver, &Receiver::on_value);
+        }
+        std::promise<void> gate;
+        core::Task blocker;
+        std::ignore = blocker.assign([gate_future = gate.get_future()] { gate_future.wait(); });
+        ASSERT_TRUE(pool.push_task(std::move(blocker)));
+        while (pool.get_queued_task_count() != 0) {
+            std::this_thread::yield();
+        }
+
+        // The first handler task fills the queue, the other ones are handled by the policy without throwing.
+        auto results = event.notify_async(nullptr, 1);
+        auto batched = event.notify_async_batched(nullptr, 1, 1);
+        const auto stats = pool.get_overflow_stats();
+        gate.set_value();
+
+        int delivered = 0;
+        for (auto& result : results) {
+            try {
+                delivered += result.get();
+            } catch (const std::future_error& error) {
+                EXPECT_EQ(error.code(), std::future_errc::broken_promise);
+            }
+        }
+        switch (policy) {
+            case core::OverflowPolicy::CallerRuns:
+                EXPECT_EQ(delivered, 4);
+                EXPECT_EQ(stats.caller_runs, 3 + 4);
+                EXPECT_TRUE(batched.get());
+                break;
+            case core::OverflowPolicy::DropOldest:
+                // Every pushed task replaces the previous one, the batch is completed with the error of dropped chunks.
+                EXPECT_EQ(delivered, 0);
+                EXPECT_EQ(stats.dropped, 3 + 4);
+                EXPECT_THROW(batched.get(), std::future_error);
+                break;
+            default:
+                EXPECT_EQ(delivered, 1);
+                EXPECT_EQ(stats.rejected, 3 + 4);
+                EXPECT_EQ(stats.blocked, policy == core::OverflowPolicy::Block ? 2 : 0);
+                EXPECT_THROW(batched.get(), std::future_error);
+                break;
+        }
+        pool.join_all();
+    }
+}
+
+TEST(EventNotificationTest, test_notify_async_drops_expired_handlers)
+{
+    Receiver receivers[2];
+    core::Event<int> event;
+    event.init_thread_pool(1, 0);
+    event.set_priority(core::TaskPriority::High);
+    event.set_deadline(std::chrono::milliseconds(1));
+    EXPECT_EQ(event.get_priority(), core::TaskPriority::High);
+    EXPECT_EQ(event.get_deadline(), std::chrono::milliseconds(1));
+    event.get_thread_pool()->set_expired_task_policy(core::ExpiredTaskPolicy::Drop);
+    for (auto& receiver : receivers) {
+        event += core::EventHandler::bind(&receiver, &Receiver::on_value);
+    }
+
+    std::promise<void> gate;
+    event.get_thread_pool()->post([gate_future = gate.get_future()] { gate_future.wait(); });
+    while (event.get_thread_pool()->get_queued_task_count() != 0) {
+        std::this_thread::yield();
+    }
+    auto expired_results = event.notify_async(nullptr, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    gate.set_value();
+    for (auto& result : expired_results) {
+        EXPECT_THROW(result.get(), std::future_error);
+    }
+
+    event.set_deadline(std::chrono::nanoseconds(0));
+    for (auto& result : event.notify_async(nullptr, 2)) {
+        EXPECT_TRUE(result.get());
+    }
+    for (auto& receiver : receivers) {
+        EXPECT_EQ(receiver.total.load(), 2);
+    }
+    EXPECT_EQ(event.get_thread_pool()->get_expired_task_count(), 2);
+}
+
+TEST(EventNotificationTest, test_dispatch_stats_and_slow_handler)
+{
+    class SlowReceiver {
+    public:
+        void on_value(const void* psender, int value)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            if (value < 0) {
+                throw std::runtime_error("negative value");
+            }
+        }
+    };
+
+    Receiver fast;
+    SlowReceiver slow;
+    core::Event<int> event;
+    auto fast_handler = core::EventHandler::bind(&fast, &Receiver::on_value);
+    auto slow_handler = core::EventHandler::bind(&slow, &SlowReceiver::on_value);
+    const auto fast_key = fast_handler->Key();
+    const auto slow_key = slow_handler->Key();
+    event += std::move(fast_handler);
+    event += std::move(slow_handler);
+
+    event.notify(nullptr, 1);
+    EXPECT_EQ(event.get_dispatch_stats().invocations, 0);
+    EXPECT_EQ(event.get_handler_stats(fast_key).invocations, 0);
+
+    std::vector<std::chrono::nanoseconds> reports;
+    event.set_dispatch_stats_enabled(true);
+    event.set_slow_handler_callback(std::chrono::milliseconds(1),
+                                    [&reports, &slow_key](const core::EventHandlerKey& key, std::chrono::nanoseconds latency) {
+                                        EXPECT_TRUE(key == slow_key);
+                                        reports.push_back(latency);
+                                    });
+    event.notify(nullptr, 1);
+    EXPECT_THROW(event.notify(nullptr, -1), std::runtime_error);
+
+    const auto event_stats = event.get_dispatch_stats();
+    EXPECT_EQ(event_stats.invocations, 2);
+    EXPECT_EQ(event_stats.exceptions, 1);
+    const auto fast_stats = event.get_handler_stats(fast_key);
+    EXPECT_EQ(fast_stats.invocations, 2);
+    EXPECT_EQ(fast_stats.exceptions, 0);
+    const auto slow_stats = event.get_handler_stats(slow_key);
+    EXPECT_EQ(slow_stats.invocations, 2);
+    EXPECT_EQ(slow_stats.exceptions, 1);
+    EXPECT_GE(slow_stats.max_latency, std::chrono::milliseconds(2));
+    EXPECT_GE(slow_stats.total_latency, std::chrono::milliseconds(4));
+    EXPECT_GE(event_stats.total_latency, slow_stats.total_latency);
+    ASSERT_EQ(reports.size(), 2);
+    EXPECT_GE(reports[0], std::chrono::milliseconds(2));
+
+    event.set_dispatch_stats_enabled(false);
+    event.set_slow_handler_callback(std::chrono::milliseconds(1), nullptr);
+    event.notify(nullptr, 1);
+    EXPECT_EQ(event.get_handler_stats(slow_key).invocations, 2);
+    EXPECT_EQ(reports.size(), 2);
+    EXPECT_EQ(fast.total.load(), 2);
+}
+
+TEST(EventNotificationTest, test_slow_handler_callback_is_not_charged_to_next_handler)
+{
+    class SlowReceiver {
+    public:
+        void on_value(const void* psender, int value) { std::this_thread::sleep_for(std::chrono::milliseconds(2)); }
+    };
+
+    SlowReceiver slow;
+    Receiver fast;
+    core::Event<int> event;
+    auto fast_handler = core::EventHandler::bind(&fast, &Receiver::on_value);
+    const auto fast_key = fast_handler->Key();
+    event += core::EventHandler::bind(&slow, &SlowReceiver::on_value);
+    event += std::move(fast_handler);
+    event.set_dispatch_stats_enabled(true);
+    event.set_slow_handler_callback(std::chrono::milliseconds(1), [](const core::EventHandlerKey&, std::chrono::nanoseconds) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    });
+
+    event.notify(nullptr, 1);
+    const auto fast_stats = event.get_handler_stats(fast_key);
+    EXPECT_EQ(fast_stats.invocations, 1);
+    EXPECT_LT(fast_stats.max_latency, std::chrono::milliseconds(25));
+    EXPECT_EQ(fast.total.load(), 1);
+}
@@ -0,0 +1,52 @@
+#include "LatencyHistogram.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+using namespace std::chrono_literals;
+
+TEST(LatencyHistogramTest, test_bucket_bounds)
+{
+    for (std::uint64_t value = 0; value < 4096; ++value) {
+        const auto bucket = core::LatencyHistogram::bucket_of(value);
+        EXPECT_GE(core::LatencyHistogram::highest_of(bucket), value);
+        if (bucket != 0) {
+            EXPECT_LT(core::LatencyHistogram::highest_of(bucket - 1), value);
+        }
+    }
+    const auto last = core::LatencyHistogram::bucket_of(std::numeric_limits<std::uint64_t>::max());
+    EXPECT_EQ(last, core::LatencyHistogram::bucket_count - 1);
+    EXPECT_EQ(core::LatencyHistogram::highest_of(last), std::numeric_limits<std::uint64_t>::max());
+}
+
+TEST(LatencyHistogramTest, test_percentiles)
+{
+    core::LatencyHistogram histogram;
+    for (int i = 1; i <= 100; ++i) {
+        histogram.record(std::chrono::microseconds(i));
+    }
+    histogram.record(-1ns);
+
+    const auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count(), 101);
+    EXPECT_EQ(snapshot.max(), 100us);
+    EXPECT_EQ(snapshot.bucket(0), 1);
+    EXPECT_EQ(snapshot.percentile(0), 0ns);
+    // Percentiles are kept with relative error below 12.5%.
+    EXPECT_GE(snapshot.percentile(50), 50us);
+    EXPECT_LE(snapshot.percentile(50), 57us);
+    EXPECT_GE(snapshot.percentile(99), 99us);
+    EXPECT_EQ(snapshot.percentile(100), 100us);
+
+    core::LatencyHistogram other;
+    other.record(1ms);
+    auto merged = snapshot;
+    merged.merge(other.snapshot());
+    EXPECT_EQ(merged.count(), 102);
+    EXPECT_EQ(merged.max(), 1ms);
+    EXPECT_EQ(merged.percentile(100), 1ms);
+    EXPECT_EQ(core::LatencyHistogram::Snapshot().percentile(50), 0ns);
+}
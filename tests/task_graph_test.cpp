@@ -0,0 +1,125 @@
+#include "TaskGraph.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+TEST(TaskGraphTest, test_diamond_order)
+{
+    core::ThreadPool pool(4, 0, core::SchedulingPolicy::WorkStealing);
+    core::TaskGraph graph;
+    std::mutex mutex;
+    std::vector<int> order;
+    const auto record = [&mutex, &order](int value) {
+        return [&mutex, &order, value] {
+            const std::lock_guard lock(mutex);
+            order.push_back(value);
+        };
+    };
+
+    const auto a = graph.add_node(record(0));
+    const auto b = graph.add_node(record(1));
+    const auto c = graph.add_node(record(1));
+    const auto d = graph.add_node(record(2));
+    graph.add_edge(a, b);
+    graph.add_edge(a, c);
+    graph.add_edge(b, d);
+    graph.add_edge(c, d);
+    EXPECT_EQ(graph.size(), 4);
+
+    graph.run(pool);
+    graph.wait();
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 1, 2}));
+}
+
+TEST(TaskGraphTest, test_graph_is_reusable)
+{
+    core::ThreadPool pool(2, 0);
+    core::TaskGraph graph;
+    std::atomic_int counter = 0;
+    auto previous = graph.add_node([&counter] { ++counter; });
+    for (int i = 0; i < 20; ++i) {
+        const auto node = graph.add_node([&counter] { ++counter; });
+        graph.add_edge(previous, node);
+        previous = node;
+    }
+
+    for (int run = 1; run <= 10; ++run) {
+        graph.run(pool);
+        graph.wait();
+        EXPECT_EQ(counter.load(), 21 * run);
+    }
+}
+
+TEST(TaskGraphTest, test_exception_skips_successors)
+{
+    core::ThreadPool pool(2, 0);
+    core::TaskGraph graph;
+    bool successor_called = false;
+    const auto failed = graph.add_node([] { throw std::runtime_error("node failed"); });
+    const auto successor = graph.add_node([&successor_called] { successor_called = true; });
+    graph.add_edge(failed, successor);
+
+    graph.run(pool);
+    EXPECT_THROW(graph.wait(), std::runtime_error);
+    EXPECT_FALSE(successor_called);
+}
+
+TEST(TaskGraphTest, test_invalid_edges)
+{
+    core::ThreadPool pool(1, 0);
+    core::TaskGraph graph;
+    const auto a = graph.add_node([] {});
+    const auto b = graph.add_node([] {});
+    EXPECT_THROW(graph.add_edge(a, 5), std::out_of_range);
+    EXPECT_THROW(graph.add_edge(a, a), std::invalid_argument);
+
+    graph.add_edge(a, b);
+    graph.add_edge(b, a);
+    EXPECT_THROW(graph.run(pool), std::logic_error);
+}
+
+TEST(TaskGraphTest, test_overflow_policies)
+{
+    for (const auto policy : {core::OverflowPolicy::Reject, core::OverflowPolicy::Block, core::OverflowPolicy::CallerRuns,
+                              core::OverflowPolicy::DropOldest, core::OverflowPolicy::Throw}) {
+        SCOPED_TRACE(static_cast<int>(policy));
+        core::ThreadPool pool(1, 1);
+        pool.set_overflow_policy(policy, std::chrono::milliseconds(10));
+        std::promise<void> gate;
+        pool.post([gate_future = gate.get_future()] { gate_future.wait(); });
+        while (pool.get_queued_task_count() != 0) {
+            std::this_thread::yield();
+        }
+
+        core::TaskGraph graph;
+        std::atomic_int counter = 0;
+        const auto a = graph.add_node([&counter] { ++counter; });
+        const auto b = graph.add_node([&counter] { ++counter; });
+        const auto c = graph.add_node([&counter] { ++counter; });
+        graph.add_edge(a, b);
+        graph.add_edge(a, c);
+        // The root node fills the queue, the next push is handled by the overflow policy.
+        graph.run(pool);
+        core::Task task;
+        std::ignore = task.assign([] {});
+        if (policy == core::OverflowPolicy::Throw) {
+            EXPECT_THROW(pool.push_task(std::move(task)), std::overflow_error);
+        } else {
+            EXPECT_EQ(pool.push_task(std::move(task)),
+                      policy == core::OverflowPolicy::CallerRuns || policy == core::OverflowPolicy::DropOldest);
+        }
+
+        gate.set_value();
+        graph.wait();
+        EXPECT_EQ(counter.load(), 3);
+        EXPECT_EQ(pool.get_overflow_stats().dropped, 0);
+    }
+}
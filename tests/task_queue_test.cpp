@@ -0,0 +1,211 @@
+#include "TaskQueue.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+class TaskQueueTypeTest : public testing::TestWithParam<core::TaskQueueType> {};
+
+core::Task make_task(core::TaskPriority priority, std::vector<int>& order, int id)
+{
+    core::Task task(priority);
+    auto result = task.assign([&order, id] { order.push_back(id); });
+    return task;
+}
+
+}  // namespace
+
+TEST_P(TaskQueueTypeTest, test_priority_order)
+{
+    core::TaskQueue queue(16, GetParam());
+    std::vector<int> order;
+    EXPECT_TRUE(queue.push(make_task(core::TaskPriority::Low, order, 0)));
+    EXPECT_TRUE(queue.push(make_task(core::TaskPriority::Highest, order, 1)));
+    EXPECT_TRUE(queue.push(make_task(core::TaskPriority::Medium, order, 2)));
+    EXPECT_EQ(queue.size(), 3);
+
+    core::Task task;
+    while (queue.try_pop(task)) {
+        task();
+    }
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 0}));
+}
+
+TEST_P(TaskQueueTypeTest, test_max_queue_size)
+{
+    core::TaskQueue queue(2, GetParam());
+    std::vector<int> order;
+    EXPECT_TRUE(queue.push(make_task(core::TaskPriority::Low, order, 0)));
+    EXPECT_TRUE(queue.push(make_task(core::TaskPriority::High, order, 1)));
+    EXPECT_FALSE(queue.push(make_task(core::TaskPriority::Medium, order, 2)));
+    EXPECT_EQ(queue.size(), 2);
+
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_TRUE(queue.push(make_task(core::TaskPriority::Medium, order, 2)));
+}
+
+TEST_P(TaskQueueTypeTest, test_release_wakes_waiting_thread)
+{
+    core::TaskQueue queue(4, GetParam());
+    std::thread consumer([&queue] { EXPECT_TRUE(queue.pop().empty()); });
+    queue.release();
+    consumer.join();
+}
+
+TEST_P(TaskQueueTypeTest, test_multiple_producers_and_consumers)
+{
+    constexpr int producer_count = 4;
+    constexpr int task_count = 1000;
+    core::TaskQueue queue(64, GetParam());
+    std::atomic_int executed = 0;
+
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < 2; ++i) {
+        consumers.emplace_back([&queue] {
+            for (;;) {
+                auto task = queue.pop();
+                if (task.empty()) {
+                    return;
+                }
+                task();
+            }
+        });
+    }
+    std::vector<std::thread> producers;
+    for (int i = 0; i < producer_count; ++i) {
+        producers.emplace_back([&queue, &executed] {
+            for (int j = 0; j < task_count; ++j) {
+                core::Task task;
+                auto result = task.assign([&executed] { executed++; });
+                while (!queue.push(std::move(task))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    while (!queue.empty()) {
+        std::this_thread::yield();
+    }
+    queue.release();
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+    EXPECT_EQ(executed.load(), producer_count * task_count);
+}
+
+TEST_P(TaskQueueTypeTest, test_fifo_order_inside_priority)
+{
+    core::TaskQueue queue(16, GetParam());
+    std::vector<int> order;
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(queue.push(make_task(core::TaskPriority::Medium, order, i)));
+    }
+
+    core::Task task;
+    while (queue.try_pop(task)) {
+        task();
+    }
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}));
+}
+
+TEST_P(TaskQueueTypeTest, test_starvation_limit)
+{
+    core::TaskQueue queue(16, GetParam());
+    queue.set_starvation_limit(2);
+    EXPECT_EQ(queue.starvation_limit(), 2);
+    std::vector<int> order;
+    EXPECT_TRUE(queue.push(make_task(core::TaskPriority::Lowest, order, 100)));
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_TRUE(queue.push(make_task(core::TaskPriority::Highest, order, i)));
+    }
+
+    core::Task task;
+    while (queue.try_pop(task)) {
+        task();
+    }
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 100, 2, 3, 4, 5}));
+}
+
+TEST_P(TaskQueueTypeTest, test_push_bulk)
+{
+    core::TaskQueue queue(3, GetParam());
+    std::vector<int> order;
+    std::vector<core::Task> tasks;
+    for (int i = 0; i < 5; ++i) {
+        tasks.push_back(make_task(i % 2 ? core::TaskPriority::High : core::TaskPriority::Low, order, i));
+    }
+
+    EXPECT_EQ(queue.push_bulk(tasks), 3);
+    EXPECT_EQ(queue.size(), 3);
+    EXPECT_TRUE(tasks[0].empty());
+    EXPECT_FALSE(tasks[3].empty());
+    EXPECT_FALSE(tasks[4].empty());
+
+    core::Task task;
+    while (queue.try_pop(task)) {
+        task();
+    }
+    EXPECT_EQ(order, (std::vector<int>{1, 0, 2}));
+}
+
+TEST_P(TaskQueueTypeTest, test_push_bulk_wakes_waiting_threads)
+{
+    core::TaskQueue queue(8, GetParam());
+    std::atomic_int executed = 0;
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < 3; ++i) {
+        consumers.emplace_back([&queue] {
+            auto task = queue.pop();
+            if (!task.empty()) {
+                task();
+            }
+        });
+    }
+
+    std::vector<core::Task> tasks(3);
+    for (auto& task : tasks) {
+        task.assign_detached([&executed] { executed++; });
+    }
+    EXPECT_EQ(queue.push_bulk(tasks), 3);
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+    EXPECT_EQ(executed.load(), 3);
+}
+
+TEST(TaskQueueTest, test_deadline_order)
+{
+    core::TaskQueue queue(16, core::TaskQueueType::Deadline);
+    std::vector<int> order;
+    const auto now = core::Task::Clock::now();
+    const auto push = [&](core::TaskPriority priority, int id, core::Task::Clock::time_point deadline) {
+        auto task = make_task(priority, order, id);
+        task.set_deadline(deadline);
+        EXPECT_TRUE(queue.push(std::move(task)));
+    };
+    push(core::TaskPriority::Highest, 0, core::Task::no_deadline);
+    push(core::TaskPriority::Low, 1, now + std::chrono::seconds(2));
+    push(core::TaskPriority::Lowest, 2, now + std::chrono::seconds(1));
+    push(core::TaskPriority::Medium, 3, now + std::chrono::seconds(2));
+    push(core::TaskPriority::Low, 4, core::Task::no_deadline);
+
+    core::Task task;
+    while (queue.try_pop(task)) {
+        task();
+    }
+    EXPECT_EQ(order, (std::vector<int>{2, 3, 1, 0, 4}));
+}
+
+INSTANTIATE_TEST_SUITE_P(TaskQueueTest, TaskQueueTypeTest,
+                         testing::Values(core::TaskQueueType::Locked, core::TaskQueueType::LockFree,
+                                         core::TaskQueueType::Deadline));
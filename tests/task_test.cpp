@@ -0,0 +1,144 @@
+#include "Task.hpp"
+#include "TaskRing.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+namespace {
+
+thread_local bool count_allocations = false;
+thread_local int allocation_count = 0;
+
+class AllocationCounter {
+public:
+    AllocationCounter()
+    {
+        allocation_count = 0;
+        count_allocations = true;
+    }
+    ~AllocationCounter() { count_allocations = false; }
+    int count() const { return allocation_count; }
+};
+
+}  // namespace
+
+void* operator new(std::size_t size)
+{
+    if (count_allocations) {
+        ++allocation_count;
+    }
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+TEST(TaskFunctionTest, test_small_callable_does_not_allocate)
+{
+    int counter = 0;
+    AllocationCounter allocations;
+    core::TaskFunction func([&counter, a = 1, b = 2] { counter += a + b; });
+    core::TaskFunction moved(std::move(func));
+    moved();
+    EXPECT_FALSE(func);
+    EXPECT_TRUE(moved);
+    EXPECT_EQ(counter, 3);
+    EXPECT_EQ(allocations.count(), 0);
+}
+
+TEST(TaskFunctionTest, test_big_callable_is_allocated_once)
+{
+    std::array<char, core::TaskFunction::buffer_size * 2> payload{};
+    payload[0] = 5;
+    int result = 0;
+    AllocationCounter allocations;
+    core::TaskFunction func([&result, payload] { result = payload[0]; });
+    core::TaskFunction moved;
+    moved = std::move(func);
+    moved();
+    EXPECT_EQ(result, 5);
+    EXPECT_EQ(allocations.count(), 1);
+}
+
+TEST(TaskFunctionTest, test_move_only_callable)
+{
+    auto value = std::make_unique<int>(7);
+    int result = 0;
+    core::TaskFunction func([&result, value = std::move(value)] { result = *value; });
+    func();
+    EXPECT_EQ(result, 7);
+    func.reset();
+    EXPECT_FALSE(func);
+}
+
+TEST(TaskTest, test_task_is_moved_without_allocation)
+{
+    core::TaskRing ring(4);
+    core::Task task(core::TaskPriority::High);
+    auto result = task.assign([](int a, int b) { return a + b; }, 2, 3);
+
+    AllocationCounter allocations;
+    EXPECT_TRUE(ring.try_push(std::move(task)));
+    EXPECT_TRUE(task.empty());
+    core::Task extracted;
+    EXPECT_TRUE(ring.try_pop(extracted));
+    EXPECT_EQ(extracted.priority(), core::TaskPriority::High);
+    EXPECT_EQ(allocations.count(), 0);
+
+    extracted();
+    EXPECT_EQ(result.get(), 5);
+}
+
+TEST(TaskTest, test_ring_lanes_share_capacity)
+{
+    core::TaskRing ring(3, core::task_priority_count);
+    EXPECT_EQ(ring.capacity(), 3);
+    EXPECT_EQ(ring.lane_count(), core::task_priority_count);
+
+    core::Task task;
+    for (int lap = 0; lap < 100; ++lap) {
+        for (int i = 0; i < 3; ++i) {
+            core::Task pushed(core::TaskPriority::Highest);
+            pushed.assign_detached([] {});
+            EXPECT_TRUE(ring.try_push(std::move(pushed), 4));
+        }
+        core::Task rejected;
+        rejected.assign_detached([] {});
+        EXPECT_FALSE(ring.try_push(std::move(rejected), 0));
+        EXPECT_FALSE(rejected.empty());
+        EXPECT_FALSE(ring.try_pop(task, 0));
+        for (int i = 0; i < 3; ++i) {
+            EXPECT_TRUE(ring.try_pop(task, 4));
+            EXPECT_EQ(task.priority(), core::TaskPriority::Highest);
+        }
+        EXPECT_FALSE(ring.try_pop(task, 4));
+    }
+
+    EXPECT_THROW(core::TaskRing(0), std::invalid_argument);
+    EXPECT_THROW(core::TaskRing(1, 0), std::invalid_argument);
+    // Memory grows with the number of task slots, not with slots times lanes.
+    constexpr std::uint32_t capacity = 1'000'000;
+    EXPECT_LT(core::TaskRing::footprint(capacity, core::task_priority_count), capacity * (sizeof(core::Task) + 64));
+}
+
+TEST(TaskTest, test_detached_task_does_not_allocate)
+{
+    int counter = 0;
+    AllocationCounter allocations;
+    core::Task task(core::TaskPriority::Low);
+    task.assign_detached([&counter](int value) { counter += value; }, 4);
+    core::Task moved(std::move(task));
+    EXPECT_EQ(allocations.count(), 0);
+
+    moved();
+    EXPECT_EQ(counter, 4);
+}
@@ -0,0 +1,651 @@
+#include "ThreadPool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+class ThreadPoolPolicyTest : public testing::TestWithParam<std::tuple<core::SchedulingPolicy, core::TaskQueueType>> {
+protected:
+    std::unique_ptr<core::ThreadPool> make_pool(std::uint32_t thread_count)
+    {
+        return make_pool(thread_count, 1000);
+    }
+
+    std::unique_ptr<core::ThreadPool> make_pool(std::uint32_t thread_count, std::uint32_t max_task_queue_size)
+    {
+        return std::make_unique<core::ThreadPool>(thread_count, max_task_queue_size, std::get<0>(GetParam()),
+                                                  std::get<1>(GetParam()));
+    }
+
+    /**
+     * @brief Occupy the only thread of the pool by a task waiting for the gate and fill the queue of size 1.
+     * @return std::future<bool> Result of the queued task.
+     */
+    std::future<bool> fill_pool(core::ThreadPool& pool, std::shared_future<void> gate_future,
+                                core::TaskPriority priority = core::TaskPriority::Medium)
+    {
+        core::Task blocker;
+        std::ignore = blocker.assign([gate_future] { gate_future.wait(); });
+        EXPECT_TRUE(pool.push_task(std::move(blocker)));
+        while (pool.get_queued_task_count() != 0) {
+            std::this_thread::yield();
+        }
+        core::Task queued(priority);
+        auto result = queued.assign([] {});
+        EXPECT_TRUE(pool.push_task(std::move(queued)));
+        return result;
+    }
+};
+
+int sum(int a, int b) { return a + b; }
+
+}  // namespace
+
+TEST_P(ThreadPoolPolicyTest, test_execute_pushed_tasks)
+{
+    auto ppool = make_pool(4);
+    auto& pool = *ppool;
+    EXPECT_EQ(pool.get_scheduling_policy(), std::get<0>(GetParam()));
+    EXPECT_EQ(pool.get_task_queue_type(), std::get<1>(GetParam()));
+
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 100; ++i) {
+        core::Task task;
+        results.push_back(task.assign(&sum, i, 1));
+        EXPECT_TRUE(pool.push_task(std::move(task)));
+    }
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(results[i].get(), i + 1);
+    }
+}
+
+TEST_P(ThreadPoolPolicyTest, test_execute_tasks_pushed_from_pool_thread)
+{
+    auto ppool = make_pool(2);
+    auto& pool = *ppool;
+    std::atomic_int counter = 0;
+
+    core::Task parent;
+    auto parent_result = parent.assign([&pool, &counter] {
+        std::vector<std::future<bool>> children;
+        for (int i = 0; i < 50; ++i) {
+            core::Task child;
+            children.push_back(child.assign([&counter] { counter++; }));
+            pool.push_task(std::move(child));
+        }
+        return children;
+    });
+    pool.push_task(std::move(parent));
+
+    for (auto& child : parent_result.get()) {
+        EXPECT_TRUE(child.get());
+    }
+    EXPECT_EQ(counter.load(), 50);
+}
+
+TEST_P(ThreadPoolPolicyTest, test_priority_order)
+{
+    auto ppool = make_pool(1);
+    auto& pool = *ppool;
+    std::promise<void> gate;
+    std::shared_future<void> gate_future = gate.get_future().share();
+    std::vector<core::TaskPriority> order;
+
+    core::Task blocker(core::TaskPriority::Highest);
+    auto blocker_result = blocker.assign([gate_future] { gate_future.wait(); });
+    pool.push_task(std::move(blocker));
+
+    const core::TaskPriority priorities[] = {core::TaskPriority::Low, core::TaskPriority::Highest,
+                                             core::TaskPriority::Lowest, core::TaskPriority::Medium,
+                                             core::TaskPriority::High};
+    std::vector<std::future<bool>> results;
+    for (auto priority : priorities) {
+        core::Task task(priority);
+        results.push_back(task.assign([&order, priority] { order.push_back(priority); }));
+        pool.push_task(std::move(task));
+    }
+    gate.set_value();
+    for (auto& result : results) {
+        result.wait();
+    }
+
+    const std::vector<core::TaskPriority> expected = {core::TaskPriority::Highest, core::TaskPriority::High,
+                                                      core::TaskPriority::Medium, core::TaskPriority::Low,
+                                                      core::TaskPriority::Lowest};
+    EXPECT_EQ(order, expected);
+}
+
+TEST_P(ThreadPoolPolicyTest, test_reset_recreates_threads)
+{
+    auto ppool = make_pool(2);
+    auto& pool = *ppool;
+    pool.reset(3);
+    EXPECT_EQ(pool.get_thread_count(), 3);
+
+    core::Task task;
+    auto result = task.assign(&sum, 2, 3);
+    EXPECT_TRUE(pool.push_task(std::move(task)));
+    EXPECT_EQ(result.get(), 5);
+}
+
+TEST(ThreadPoolTest, test_bounded_queue_rejects_task)
+{
+    core::ThreadPool pool(1, 1, core::SchedulingPolicy::WorkStealing);
+    std::promise<void> gate;
+    std::shared_future<void> gate_future = gate.get_future().share();
+
+    core::Task blocker;
+    auto blocker_result = blocker.assign([gate_future] { gate_future.wait(); });
+    EXPECT_TRUE(pool.push_task(std::move(blocker)));
+    while (pool.get_queued_task_count() != 0) {
+        std::this_thread::yield();
+    }
+
+    core::Task first;
+    auto first_result = first.assign([] {});
+    EXPECT_TRUE(pool.push_task(std::move(first)));
+    core::Task second;
+    auto second_result = second.assign([] {});
+    EXPECT_FALSE(pool.push_task(std::move(second)));
+    EXPECT_EQ(pool.get_total_task_count(), 2);
+
+    gate.set_value();
+    EXPECT_TRUE(first_result.get());
+}
+
+TEST_P(ThreadPoolPolicyTest, test_post_routes_exceptions_to_error_handler)
+{
+    auto ppool = make_pool(2);
+    auto& pool = *ppool;
+    std::atomic_int counter = 0;
+    std::promise<std::string> error;
+    auto error_future = error.get_future();
+    pool.set_error_handler([&error](std::exception_ptr perror) {
+        try {
+            std::rethrow_exception(perror);
+        } catch (const std::exception& e) {
+            error.set_value(e.what());
+        }
+    });
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(pool.post([&counter](int value) { counter += value; }, 2));
+    }
+    EXPECT_TRUE(pool.post([] { throw std::runtime_error("task failed"); }));
+    EXPECT_EQ(error_future.get(), "task failed");
+    pool.join_all();
+    EXPECT_EQ(counter.load(), 20);
+}
+
+TEST_P(ThreadPoolPolicyTest, test_push_tasks)
+{
+    auto ppool = make_pool(3);
+    auto& pool = *ppool;
+    std::vector<core::Task> tasks(20);
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 20; ++i) {
+        results.push_back(tasks[i].assign(&sum, i, i));
+    }
+
+    EXPECT_EQ(pool.push_tasks(tasks), 20);
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(results[i].get(), 2 * i);
+    }
+}
+
+TEST_P(ThreadPoolPolicyTest, test_parallel_for_visits_every_index_once)
+{
+    auto ppool = make_pool(4);
+    auto& pool = *ppool;
+    std::vector<std::atomic_int> visits(10007);
+    pool.parallel_for(std::size_t{0}, visits.size(), std::size_t{16}, [&visits](std::size_t i) { ++visits[i]; });
+    for (const auto& visit : visits) {
+        EXPECT_EQ(visit.load(), 1);
+    }
+
+    pool.parallel_for(5, 5, 1, [](int) { FAIL(); });
+}
+
+TEST_P(ThreadPoolPolicyTest, test_parallel_for_from_pool_thread)
+{
+    auto ppool = make_pool(2);
+    auto& pool = *ppool;
+    std::atomic_int counter = 0;
+    core::Task task;
+    auto result = task.assign([&pool, &counter] {
+        for (int i = 0; i < 8; ++i) {
+            pool.parallel_for(0, 100, 1, [&counter](int) { ++counter; });
+        }
+    });
+    EXPECT_TRUE(pool.push_task(std::move(task)));
+    EXPECT_TRUE(result.get());
+    EXPECT_EQ(counter.load(), 800);
+}
+
+TEST_P(ThreadPoolPolicyTest, test_parallel_for_rethrows_exception)
+{
+    auto ppool = make_pool(3);
+    auto& pool = *ppool;
+    EXPECT_THROW(pool.parallel_for(0, 1000, 1,
+                                   [](int i) {
+                                       if (i == 500) {
+                                           throw std::runtime_error("parallel_for");
+                                       }
+                                   }),
+                 std::runtime_error);
+}
+
+TEST_P(ThreadPoolPolicyTest, test_parallel_reduce)
+{
+    auto ppool = make_pool(4);
+    auto& pool = *ppool;
+    const auto sum = pool.parallel_reduce(
+        std::int64_t{1}, std::int64_t{100001}, std::int64_t{64}, std::int64_t{0},
+        [](std::int64_t first, std::int64_t last, std::int64_t init) {
+            for (auto i = first; i < last; ++i) {
+                init += i;
+            }
+            return init;
+        },
+        [](std::int64_t a, std::int64_t b) { return a + b; });
+    EXPECT_EQ(sum, std::int64_t{100000} * 100001 / 2);
+}
+
+TEST_P(ThreadPoolPolicyTest, test_parallel_reduce_range_larger_than_int)
+{
+    auto ppool = make_pool(4);
+    auto& pool = *ppool;
+    // Chunks are counted, not indices, so the range may exceed the max count of std::latch.
+    const auto size = std::uint64_t{1} << 40;
+    const auto total = pool.parallel_reduce(
+        std::uint64_t{0}, size, std::uint64_t{1}, std::uint64_t{0},
+        [](std::uint64_t first, std::uint64_t last, std::uint64_t init) { return init + (last - first); },
+        [](std::uint64_t a, std::uint64_t b) { return a + b; });
+    EXPECT_EQ(total, size);
+}
+
+TEST_P(ThreadPoolPolicyTest, test_reentrant_task_is_executed_inline)
+{
+    auto ppool = make_pool(1);
+    auto& pool = *ppool;
+    std::promise<std::thread::id> child_thread;
+    auto child_thread_future = child_thread.get_future();
+    core::Task parent;
+    auto parent_thread = parent.assign([&pool, &child_thread] {
+        core::Task child;
+        child.assign_detached([&child_thread] { child_thread.set_value(std::this_thread::get_id()); });
+        pool.push_task(std::move(child));
+        return std::this_thread::get_id();
+    });
+    EXPECT_TRUE(pool.push_task(std::move(parent)));
+
+    EXPECT_EQ(child_thread_future.get(), parent_thread.get());
+    pool.join_all();
+    EXPECT_EQ(pool.get_reentrant_task_count(), 1);
+}
+
+TEST_P(ThreadPoolPolicyTest, test_reentrant_task_is_rescheduled_once)
+{
+    auto ppool = make_pool(2);
+    auto& pool = *ppool;
+    std::atomic_int counter = 0;
+    core::Task parent;
+    auto parent_result = parent.assign([&pool, &counter] {
+        for (int i = 0; i < 10; ++i) {
+            core::Task child(core::TaskPriority::Medium, core::ExecutionPolicy::Reschedule);
+            child.assign_detached([&counter] { ++counter; });
+            pool.push_task(std::move(child));
+        }
+    });
+    EXPECT_TRUE(pool.push_task(std::move(parent)));
+    EXPECT_TRUE(parent_result.get());
+
+    pool.join_all();
+    EXPECT_EQ(counter.load(), 10);
+    EXPECT_EQ(pool.get_total_task_count(), 0);
+}
+
+TEST_P(ThreadPoolPolicyTest, test_rescheduled_task_is_counted_once)
+{
+    auto ppool = make_pool(2);
+    auto& pool = *ppool;
+    std::promise<void> gate;
+    std::promise<void> started;
+    core::Task blocker;
+    std::ignore = blocker.assign([gate_future = gate.get_future().share(), &started] {
+        started.set_value();
+        gate_future.wait();
+    });
+    EXPECT_TRUE(pool.push_task(std::move(blocker)));
+    started.get_future().wait();
+
+    // The other thread is busy, so every rescheduled child is picked up by the thread which pushed it again.
+    std::atomic_int counter = 0;
+    std::promise<void> done;
+    core::Task parent;
+    std::ignore = parent.assign([&pool, &counter, &done] {
+        for (int i = 0; i < 10; ++i) {
+            core::Task child(core::TaskPriority::Medium, core::ExecutionPolicy::Reschedule);
+            child.assign_detached([&counter, &done] {
+                if (++counter == 10) {
+                    done.set_value();
+                }
+            });
+            pool.push_task(std::move(child));
+        }
+    });
+    EXPECT_TRUE(pool.push_task(std::move(parent)));
+    done.get_future().wait();
+    gate.set_value();
+
+    pool.join_all();
+    EXPECT_EQ(pool.get_reentrant_task_count(), 10);
+}
+
+TEST_P(ThreadPoolPolicyTest, test_overflow_reject_and_throw)
+{
+    auto ppool = make_pool(1, 1);
+    auto& pool = *ppool;
+    std::promise<void> gate;
+    auto queued_result = fill_pool(pool, gate.get_future().share());
+
+    core::Task rejected;
+    EXPECT_FALSE(pool.push_task(std::move(rejected)));
+    pool.set_overflow_policy(core::OverflowPolicy::Throw);
+    EXPECT_EQ(pool.get_overflow_policy(), core::OverflowPolicy::Throw);
+    core::Task thrown;
+    EXPECT_THROW(pool.push_task(std::move(thrown)), std::overflow_error);
+    EXPECT_EQ(pool.get_overflow_stats().rejected, 2);
+
+    gate.set_value();
+    EXPECT_TRUE(queued_result.get());
+}
+
+TEST_P(ThreadPoolPolicyTest, test_overflow_caller_runs_and_drop_oldest)
+{
+    auto ppool = make_pool(1, 1);
+    auto& pool = *ppool;
+    std::promise<void> gate;
+    auto low_result = fill_pool(pool, gate.get_future().share(), core::TaskPriority::Low);
+
+    pool.set_overflow_policy(core::OverflowPolicy::CallerRuns);
+    core::Task inline_task;
+    auto inline_result = inline_task.assign([] { return std::this_thread::get_id(); });
+    EXPECT_TRUE(pool.push_task(std::move(inline_task)));
+    EXPECT_EQ(inline_result.get(), std::this_thread::get_id());
+
+    pool.set_overflow_policy(core::OverflowPolicy::DropOldest);
+    core::Task high(core::TaskPriority::High);
+    auto high_result = high.assign([] {});
+    EXPECT_TRUE(pool.push_task(std::move(high)));
+    EXPECT_THROW(low_result.get(), std::future_error);
+    core::Task lowest(core::TaskPriority::Lowest);
+    EXPECT_FALSE(pool.push_task(std::move(lowest)));
+
+    const auto stats = pool.get_overflow_stats();
+    EXPECT_EQ(stats.caller_runs, 1);
+    EXPECT_EQ(stats.dropped, 1);
+    EXPECT_EQ(stats.rejected, 1);
+    gate.set_value();
+    EXPECT_TRUE(high_result.get());
+}
+
+TEST_P(ThreadPoolPolicyTest, test_overflow_block_with_timeout)
+{
+    auto ppool = make_pool(1, 1);
+    auto& pool = *ppool;
+    std::promise<void> gate;
+    auto queued_result = fill_pool(pool, gate.get_future().share());
+
+    pool.set_overflow_policy(core::OverflowPolicy::Block, std::chrono::milliseconds(10));
+    core::Task timed_out;
+    EXPECT_FALSE(pool.push_task(std::move(timed_out)));
+
+    pool.set_overflow_policy(core::OverflowPolicy::Block, std::chrono::seconds(10));
+    std::thread releaser([&gate] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        gate.set_value();
+    });
+    core::Task blocked;
+    auto blocked_result = blocked.assign([] {});
+    EXPECT_TRUE(pool.push_task(std::move(blocked)));
+    releaser.join();
+    EXPECT_TRUE(blocked_result.get());
+    EXPECT_TRUE(queued_result.get());
+
+    const auto stats = pool.get_overflow_stats();
+    EXPECT_EQ(stats.blocked, 2);
+    EXPECT_EQ(stats.timed_out, 1);
+    EXPECT_EQ(stats.rejected, 1);
+}
+
+TEST_P(ThreadPoolPolicyTest, test_overflow_block_wakes_every_producer)
+{
+    auto ppool = make_pool(1, 1);
+    auto& pool = *ppool;
+    pool.set_overflow_policy(core::OverflowPolicy::Block, std::chrono::seconds(10));
+    std::promise<void> gate;
+    auto queued_result = fill_pool(pool, gate.get_future().share());
+
+    // Every executed task wakes one blocked producer, which pushes into the freed slot.
+    std::atomic_int executed = 0;
+    std::vector<std::thread> producers;
+    for (int i = 0; i < 4; ++i) {
+        producers.emplace_back([&pool, &executed] {
+            core::Task task;
+            task.assign_detached([&executed] { ++executed; });
+            EXPECT_TRUE(pool.push_task(std::move(task)));
+        });
+    }
+    while (pool.get_overflow_stats().blocked != 4) {
+        std::this_thread::yield();
+    }
+    gate.set_value();
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_TRUE(queued_result.get());
+    pool.join_all();
+    EXPECT_EQ(executed.load(), 4);
+
+    const auto stats = pool.get_overflow_stats();
+    EXPECT_EQ(stats.timed_out, 0);
+    EXPECT_EQ(stats.rejected, 0);
+}
+
+TEST_P(ThreadPoolPolicyTest, test_expired_task_policy)
+{
+    auto ppool = make_pool(1, 4);
+    auto& pool = *ppool;
+    EXPECT_EQ(pool.get_expired_task_policy(), core::ExpiredTaskPolicy::Run);
+    std::atomic_int executed = 0;
+    const auto push_expired = [&pool, &executed] {
+        core::Task task;
+        task.set_deadline(core::Task::Clock::now());
+        auto result = task.assign([&executed] { executed++; });
+        EXPECT_TRUE(pool.push_task(std::move(task)));
+        return result;
+    };
+
+    std::promise<void> run_gate;
+    auto run_queued = fill_pool(pool, run_gate.get_future().share());
+    auto run_result = push_expired();
+    run_gate.set_value();
+    EXPECT_TRUE(run_queued.get());
+    EXPECT_TRUE(run_result.get());
+
+    pool.set_expired_task_policy(core::ExpiredTaskPolicy::Drop);
+    std::promise<void> drop_gate;
+    auto drop_queued = fill_pool(pool, drop_gate.get_future().share());
+    auto drop_result = push_expired();
+    core::Task in_time;
+    in_time.set_deadline(core::Task::Clock::now() + std::chrono::hours(1));
+    auto in_time_result = in_time.assign([&executed] { executed++; });
+    EXPECT_TRUE(pool.push_task(std::move(in_time)));
+    drop_gate.set_value();
+    EXPECT_TRUE(drop_queued.get());
+    EXPECT_THROW(drop_result.get(), std::future_error);
+    EXPECT_TRUE(in_time_result.get());
+
+    EXPECT_EQ(executed.load(), 2);
+    EXPECT_EQ(pool.get_expired_task_count(), 2);
+    pool.join_all();
+    EXPECT_EQ(pool.get_total_task_count(), 0);
+}
+
+TEST_P(ThreadPoolPolicyTest, test_metrics)
+{
+    auto ppool = make_pool(2);
+    auto& pool = *ppool;
+    for (int i = 0; i < 10; ++i) {
+        core::Task task(core::TaskPriority::High);
+        std::ignore = task.assign([] { std::this_thread::sleep_for(std::chrono::microseconds(100)); });
+        EXPECT_TRUE(pool.push_task(std::move(task)));
+    }
+    EXPECT_TRUE(pool.post([] { throw std::runtime_error("error"); }));
+    pool.join_all();
+
+    const auto metrics = pool.get_metrics();
+#ifdef CORE_ENABLE_METRICS
+    ASSERT_EQ(metrics.workers.size(), 2);
+    std::uint64_t executed = 0;
+    std::uint64_t failed = 0;
+    for (const auto& worker : metrics.workers) {
+        executed += worker.executed;
+        failed += worker.failed;
+        EXPECT_LE(worker.utilisation, 1.0);
+    }
+    EXPECT_EQ(executed, 11);
+    EXPECT_EQ(failed, 1);
+    EXPECT_EQ(metrics.queue_wait[static_cast<std::size_t>(core::TaskPriority::High)].count(), 10);
+    EXPECT_EQ(metrics.execution[static_cast<std::size_t>(core::TaskPriority::High)].count(), 10);
+    EXPECT_GE(metrics.execution[static_cast<std::size_t>(core::TaskPriority::High)].percentile(50),
+              std::chrono::microseconds(100));
+    EXPECT_EQ(metrics.execution[static_cast<std::size_t>(core::TaskPriority::Medium)].count(), 1);
+#else
+    EXPECT_TRUE(metrics.workers.empty());
+#endif
+}
+
+TEST(ThreadPoolTest, test_push_tasks_to_bounded_queue)
+{
+    core::ThreadPool pool(1, 2);
+    std::promise<void> gate;
+    EXPECT_TRUE(pool.post([gate_future = gate.get_future()] { gate_future.wait(); }));
+    while (pool.get_queued_task_count() != 0) {
+        std::this_thread::yield();
+    }
+    std::vector<core::Task> tasks(4);
+    for (auto& task : tasks) {
+        task.assign_detached([] {});
+    }
+
+    const auto pushed = pool.push_tasks(tasks);
+    EXPECT_EQ(pushed, 2);
+    EXPECT_EQ(pool.get_total_task_count(), pushed + 1);
+    EXPECT_FALSE(tasks[2].empty());
+    EXPECT_FALSE(tasks[3].empty());
+    gate.set_value();
+}
+
+TEST(ThreadPoolTest, test_post_member_function)
+{
+    struct Accumulator {
+        void add(int value) { total += value; }
+        std::atomic_int total = 0;
+    } accumulator;
+
+    core::ThreadPool pool(2, 0);
+    for (int i = 1; i <= 4; ++i) {
+        EXPECT_TRUE(pool.post(&Accumulator::add, &accumulator, i));
+    }
+    pool.join_all();
+    EXPECT_EQ(accumulator.total.load(), 10);
+}
+
+TEST(ThreadPoolTest, test_lock_free_queue_requires_max_size)
+{
+    EXPECT_THROW(core::ThreadPool(1, 0, core::SchedulingPolicy::SharedQueue, core::TaskQueueType::LockFree),
+                 std::invalid_argument);
+}
+
+TEST(ThreadPoolTest, test_cpu_affinity)
+{
+    const auto cpu = core::CpuTopology::allowed_cpus().back();
+    core::ThreadPool pool(2, 0, core::SchedulingPolicy::WorkStealing);
+#ifdef __linux__
+    EXPECT_TRUE(pool.set_cpu_affinity({cpu}));
+#else
+    pool.set_cpu_affinity({cpu});
+#endif
+    EXPECT_EQ(pool.get_cpu_affinity(), std::vector<std::uint32_t>{cpu});
+    // Threads created by reset() are pinned on start.
+    pool.reset(3);
+    std::vector<std::future<std::optional<std::uint32_t>>> results;
+    for (int i = 0; i < 20; ++i) {
+        core::Task task;
+        results.push_back(task.assign([] { return core::CpuTopology::current_cpu(); }));
+        EXPECT_TRUE(pool.push_task(std::move(task)));
+    }
+    for (auto& result : results) {
+        const auto current = result.get();
+        if (current) {
+            EXPECT_EQ(*current, cpu);
+        }
+    }
+}
+
+TEST(ThreadPoolTest, test_numa_sub_pools)
+{
+    // Both nodes share one CPU, so the test does not depend on the machine topology.
+    const auto cpu = core::CpuTopology::allowed_cpus().front();
+    core::ThreadPool pool(4, 0, core::SchedulingPolicy::NumaWorkStealing, core::TaskQueueType::Locked,
+                          {{0, {cpu}}, {1, {cpu}}});
+    ASSERT_EQ(pool.get_numa_nodes().size(), 2);
+    EXPECT_EQ(pool.get_thread_numa_node(0), 0);
+    EXPECT_EQ(pool.get_thread_numa_node(1), 0);
+    EXPECT_EQ(pool.get_thread_numa_node(2), 1);
+    EXPECT_EQ(pool.get_thread_numa_node(3), 1);
+
+    std::atomic_int counter = 0;
+    std::vector<core::Task> tasks(100);
+    for (auto& task : tasks) {
+        task.assign_detached([&counter] {
+            std::this_thread::sleep_for(std::chrono::microseconds(10));
+            ++counter;
+        });
+    }
+    EXPECT_EQ(pool.push_tasks(tasks), 100);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(pool.post([&counter] { ++counter; }));
+    }
+    pool.join_all();
+    EXPECT_EQ(counter.load(), 200);
+    EXPECT_EQ(pool.get_total_task_count(), 0);
+
+    // Explicitly pinned threads belong to the node of their CPU.
+    pool.set_cpu_affinity({cpu});
+    pool.reset(2);
+    EXPECT_EQ(pool.get_thread_numa_node(0), 0);
+    EXPECT_EQ(pool.get_thread_numa_node(1), 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(ThreadPoolTest, ThreadPoolPolicyTest,
+                         testing::Combine(testing::Values(core::SchedulingPolicy::SharedQueue,
+                                                          core::SchedulingPolicy::WorkStealing,
+                                                          core::SchedulingPolicy::NumaWorkStealing),
+                                          testing::Values(core::TaskQueueType::Locked,
+                                                          core::TaskQueueType::LockFree,
+                                                          core::TaskQueueType::Deadline)));
@@ -0,0 +1,145 @@
+#include "Event.hpp"
+#include "EventHandler.hpp"
+#include "ThreadPool.hpp"
+#include "TraceRecorder.hpp"
+
+#include <gtest/gtest.h>
+#include <json/json.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+
+Json::Value parse_trace(const core::TraceRecorder& recorder)
+{
+    std::stringstream stream;
+    recorder.dump(stream);
+    Json::Value root;
+    std::string errors;
+    EXPECT_TRUE(Json::parseFromStream(Json::CharReaderBuilder(), stream, &root, &errors)) << errors;
+    return root;
+}
+
+class Receiver {
+public:
+    void on_value(const void* psender, int value) {}
+};
+
+}  // namespace
+
+TEST(TraceRecorderTest, test_dump_chrome_trace)
+{
+    auto& recorder = core::TraceRecorder::instance();
+    recorder.start();
+    recorder.set_thread_name("main \"thread\"");
+    recorder.record({"inner", "test", core::TraceRecorder::now(), 1500, 7, core::TraceFlow::Out});
+    std::thread([&recorder] { recorder.record({"other", "test", core::TraceRecorder::now(), 0, 7, core::TraceFlow::In}); })
+      .join();
+    recorder.stop();
+    recorder.record({"ignored", "test", core::TraceRecorder::now(), 0});
+
+    const auto root = parse_trace(recorder);
+    const auto& events = root["traceEvents"];
+    ASSERT_EQ(events.size(), 3);
+    std::map<std::string, Json::Value> by_name;
+    for (const auto& event : events) {
+        by_name[event["name"].asString()] = event;
+    }
+    EXPECT_EQ(by_name["thread_name"]["ph"].asString(), "M");
+    EXPECT_EQ(by_name["thread_name"]["args"]["name"].asString(), "main \"thread\"");
+    EXPECT_EQ(by_name["thread_name"]["tid"], by_name["inner"]["tid"]);
+    EXPECT_EQ(by_name["inner"]["ph"].asString(), "X");
+    EXPECT_DOUBLE_EQ(by_name["inner"]["dur"].asDouble(), 1.5);
+    EXPECT_TRUE(by_name["inner"]["flow_out"].asBool());
+    EXPECT_TRUE(by_name["other"]["flow_in"].asBool());
+    EXPECT_EQ(by_name["inner"]["bind_id"], by_name["other"]["bind_id"]);
+    EXPECT_NE(by_name["inner"]["tid"], by_name["other"]["tid"]);
+
+    recorder.clear();
+    EXPECT_TRUE(recorder.records().empty());
+}
+
+TEST(TraceRecorderTest, test_ring_overwrites_oldest_records)
+{
+    auto& recorder = core::TraceRecorder::instance();
+    recorder.start(3);
+    for (std::uint64_t i = 1; i <= 10; ++i) {
+        recorder.record({"slice", "test", i, 0});
+    }
+    recorder.stop();
+
+    const auto records = recorder.records();
+    ASSERT_EQ(records.size(), 4);
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        EXPECT_EQ(records[i].timestamp, 7 + i);
+        EXPECT_STREQ(records[i].name, "slice");
+    }
+    recorder.clear();
+}
+
+TEST(TraceRecorderTest, test_thread_pool_and_event_timeline)
+{
+    auto& recorder = core::TraceRecorder::instance();
+    Receiver receivers[2];
+    core::Event<int> event;
+    event.init_thread_pool(2, 0);
+    for (auto& receiver : receivers) {
+        event += core::EventHandler::bind(&receiver, &Receiver::on_value);
+    }
+
+    recorder.start();
+    for (auto& result : event.notify_async(nullptr, 1)) {
+        EXPECT_TRUE(result.get());
+    }
+#ifdef CORE_ENABLE_TRACING
+    // Execution slices are recorded after the task has set its result.
+    const auto executed = [&recorder] {
+        const auto records = recorder.records();
+        return std::count_if(records.begin(), records.end(),
+                             [](const auto& record) { return std::strcmp(record.name, "execute") == 0; });
+    };
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (executed() < 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+#endif
+    recorder.stop();
+
+    const auto records = recorder.records();
+    recorder.clear();
+#ifdef CORE_ENABLE_TRACING
+    std::map<std::uint64_t, int> flows;
+    const core::TraceRecord* pNotify = nullptr;
+    for (const auto& record : records) {
+        if (std::strcmp(record.name, "notify_async") == 0) {
+            pNotify = &record;
+        } else if (record.flow == core::TraceFlow::Out) {
+            EXPECT_STREQ(record.name, "push");
+            flows[record.flow_id] += 1;
+        } else if (record.flow == core::TraceFlow::In) {
+            EXPECT_STREQ(record.name, "execute");
+            flows[record.flow_id] += 2;
+        }
+    }
+    ASSERT_NE(pNotify, nullptr);
+    // Every task is connected from the push inside notify_async() to its execution by a worker.
+    ASSERT_EQ(flows.size(), 2);
+    for (const auto& [id, sides] : flows) {
+        EXPECT_EQ(sides, 3) << id;
+    }
+    for (const auto& record : records) {
+        if (record.flow == core::TraceFlow::Out) {
+            EXPECT_GE(record.timestamp, pNotify->timestamp);
+            EXPECT_LE(record.timestamp, pNotify->timestamp + pNotify->duration);
+        }
+    }
+#else
+    EXPECT_TRUE(records.empty());
+#endif
+}